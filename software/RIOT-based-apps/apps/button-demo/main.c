@@ -4,6 +4,25 @@
 #include "led_matrix.h"
 #include "button_matrix.h"
 
+static const button_matrix_coord_t buttons[] = {
+    { BUTTON_MATRIX_COORD_UP },
+    { BUTTON_MATRIX_COORD_DOWN },
+    { BUTTON_MATRIX_COORD_LEFT },
+    { BUTTON_MATRIX_COORD_RIGHT },
+    { BUTTON_MATRIX_COORD_A },
+    { BUTTON_MATRIX_COORD_B },
+};
+
+/* top left corner of the square lit for each button */
+static const uint8_t squares[][2] = {
+    { 2, 0 },
+    { 2, 4 },
+    { 0, 2 },
+    { 4, 2 },
+    { 8, 6 },
+    { 5, 7 },
+};
+
 int main(void)
 {
     int retval;
@@ -20,46 +39,18 @@ int main(void)
     while (1) {
         led_matrix_fb_clear();
 
-        if (button_matrix_test(BUTTON_MATRIX_COORD_UP)) {
-            led_matrix_fb_set(2, 0, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(3, 0, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(2, 1, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(3, 1, LED_MATRIX_BRIGHTNESS_MAX);
-        }
-
-        if (button_matrix_test(BUTTON_MATRIX_COORD_DOWN)) {
-            led_matrix_fb_set(2, 4, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(3, 4, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(2, 5, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(3, 5, LED_MATRIX_BRIGHTNESS_MAX);
-        }
-
-        if (button_matrix_test(BUTTON_MATRIX_COORD_LEFT)) {
-            led_matrix_fb_set(0, 2, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(1, 2, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(0, 3, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(1, 3, LED_MATRIX_BRIGHTNESS_MAX);
-        }
-
-        if (button_matrix_test(BUTTON_MATRIX_COORD_RIGHT)) {
-            led_matrix_fb_set(4, 2, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(5, 2, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(4, 3, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(5, 3, LED_MATRIX_BRIGHTNESS_MAX);
-        }
-
-        if (button_matrix_test(BUTTON_MATRIX_COORD_A)) {
-            led_matrix_fb_set(8, 6, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(9, 6, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(8, 7, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(9, 7, LED_MATRIX_BRIGHTNESS_MAX);
-        }
-
-        if (button_matrix_test(BUTTON_MATRIX_COORD_B)) {
-            led_matrix_fb_set(5, 7, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(6, 7, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(5, 8, LED_MATRIX_BRIGHTNESS_MAX);
-            led_matrix_fb_set(6, 8, LED_MATRIX_BRIGHTNESS_MAX);
+        uint8_t pressed;
+        button_matrix_test_batch(buttons, ARRAY_SIZE(buttons), &pressed);
+
+        for (unsigned i = 0; i < ARRAY_SIZE(buttons); i++) {
+            if (pressed & (1U << i)) {
+                uint8_t x = squares[i][0];
+                uint8_t y = squares[i][1];
+                led_matrix_fb_set(x, y, LED_MATRIX_BRIGHTNESS_MAX);
+                led_matrix_fb_set(x + 1, y, LED_MATRIX_BRIGHTNESS_MAX);
+                led_matrix_fb_set(x, y + 1, LED_MATRIX_BRIGHTNESS_MAX);
+                led_matrix_fb_set(x + 1, y + 1, LED_MATRIX_BRIGHTNESS_MAX);
+            }
         }
 
         target_frame = led_matrix_fb_switch(target_frame);
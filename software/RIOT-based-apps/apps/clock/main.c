@@ -0,0 +1,268 @@
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "board.h"
+#include "button_matrix.h"
+#include "button_matrix_events.h"
+#include "button_matrix_params.h"
+#include "fmt.h"
+#include "led_matrix.h"
+#include "led_matrix_params.h"
+#include "mutex.h"
+#include "periph/rtc.h"
+#include "thread.h"
+
+/* scroll the time as text instead of showing the clock face, as a baseline
+ * for the cost of the clock face */
+#ifndef CONFIG_CLOCK_SCROLL
+#  define CONFIG_CLOCK_SCROLL   0
+#endif
+
+/* print the rendering work done every minute via stdio */
+#ifndef CONFIG_CLOCK_STATS
+#  define CONFIG_CLOCK_STATS    0
+#endif
+
+/* the minutes are shown as dots below the hours: tens and ones */
+#define ROW_TENS    6
+#define ROW_ONES    8
+
+static mutex_t display_lock = MUTEX_INIT;
+/* unlocked by the RTC alarm at the start of every minute */
+static mutex_t tick = MUTEX_INIT_LOCKED;
+static char clock_stack[THREAD_STACKSIZE_SMALL];
+
+/* frames rendered in the minute being shown */
+static unsigned renders;
+
+/* set the RTC to the time the firmware was built, if it has not been set */
+static void rtc_init_time(void)
+{
+    static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    const char *date = __DATE__;    /* e.g. "Oct 19 2026" */
+    const char *clock = __TIME__;   /* e.g. "12:34:56" */
+    struct tm time;
+
+    rtc_get_time(&time);
+    if (time.tm_year + 1900 >= 2024) {
+        return;
+    }
+
+    memset(&time, 0, sizeof(time));
+    for (int i = 0; i < 12; i++) {
+        if (!memcmp(&months[3 * i], date, 3)) {
+            time.tm_mon = i;
+        }
+    }
+    time.tm_mday = atoi(&date[4]);
+    time.tm_year = atoi(&date[7]) - 1900;
+    time.tm_hour = atoi(&clock[0]);
+    time.tm_min = atoi(&clock[3]);
+    time.tm_sec = atoi(&clock[6]);
+    rtc_tm_normalize(&time);
+    rtc_set_time(&time);
+}
+
+static void print_stats(void)
+{
+    if (!CONFIG_CLOCK_STATS) {
+        return;
+    }
+
+    static uint32_t last_isrs, last_frame;
+    uint32_t isrs = led_matrix_isr_count();
+    uint32_t frame = led_matrix_frame_number();
+    /* count over the frames shown since the last call, not wall time */
+    uint32_t isr_rate = (isrs - last_isrs) * LED_MATRIX_FPS / (frame - last_frame);
+    last_isrs = isrs;
+    last_frame = frame;
+
+    mutex_lock(&display_lock);
+    printf("renders: %u/min, refresh ISR: %" PRIu32 "/s\n", renders, isr_rate);
+    renders = 0;
+    mutex_unlock(&display_lock);
+}
+
+static void draw_face(const struct tm *time)
+{
+    char hours[2];
+    size_t len = fmt_u32_dec(hours, time->tm_hour);
+    int width = bitmap_font_render_width(&bitmap_font_tiny5, hours, len);
+
+    led_matrix_fb_clear();
+    led_matrix_text(&bitmap_font_tiny5, hours, len, ((int)LED_MATRIX_WIDTH - width) / 2, 0,
+                    LED_MATRIX_BRIGHTNESS_MAX);
+
+    /* dots are grouped by five for counting at a glance */
+    for (int i = 0; i < time->tm_min / 10; i++) {
+        led_matrix_fb_set(i + i / 5, ROW_TENS, LED_MATRIX_BRIGHTNESS_MAX);
+    }
+    for (int i = 0; i < time->tm_min % 10; i++) {
+        led_matrix_fb_set(i + i / 5, ROW_ONES, LED_MATRIX_BRIGHTNESS_MAX);
+    }
+
+    led_matrix_fb_switch(led_matrix_frame_number());
+    renders++;
+}
+
+static void alarm_cb(void *arg)
+{
+    (void)arg;
+    mutex_unlock(&tick);
+}
+
+/* draw the current time and wake up again once it changes */
+static void show_time(void)
+{
+    struct tm now, alarm;
+
+    mutex_lock(&display_lock);
+    rtc_get_time(&now);
+    draw_face(&now);
+
+    alarm = now;
+    alarm.tm_sec = 0;
+    alarm.tm_min++;
+    rtc_tm_normalize(&alarm);
+    rtc_set_alarm(&alarm, alarm_cb, NULL);
+
+    /* the alarm is missed if the minute passed while setting it */
+    int shown = now.tm_min;
+    rtc_get_time(&now);
+    if (now.tm_min != shown) {
+        mutex_unlock(&tick);
+    }
+    mutex_unlock(&display_lock);
+}
+
+static void *clock_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        show_time();
+        mutex_lock(&tick);
+        print_stats();
+    }
+
+    return NULL;
+}
+
+static void show_date(void)
+{
+    struct tm now;
+    char text[sizeof("31.12.2099")];
+
+    rtc_get_time(&now);
+    size_t len = fmt_u32_dec(text, now.tm_mday);
+    text[len++] = '.';
+    len += fmt_u32_dec(&text[len], now.tm_mon + 1);
+    text[len++] = '.';
+    len += fmt_u32_dec(&text[len], now.tm_year + 1900);
+
+    mutex_lock(&display_lock);
+    led_matrix_text_scroll(&bitmap_font_matrix_light8, text, len, LED_MATRIX_BRIGHTNESS_MAX);
+    renders += LED_MATRIX_WIDTH + bitmap_font_render_width(&bitmap_font_matrix_light8, text, len);
+    mutex_unlock(&display_lock);
+}
+
+static void adjust_time(int minutes)
+{
+    struct tm now;
+
+    rtc_get_time(&now);
+    now.tm_min += minutes;
+    now.tm_sec = 0;
+    rtc_tm_normalize(&now);
+    rtc_set_time(&now);
+}
+
+static void run_face(void)
+{
+    /* a static image needs neither dimming nor more than a frame switch per
+     * minute */
+    led_matrix_set_refresh(LED_MATRIX_REFRESH_MONO);
+
+    thread_create(clock_stack, sizeof(clock_stack), THREAD_PRIORITY_MAIN - 1, 0,
+                  clock_thread, NULL, "clock");
+
+    while (1) {
+        button_matrix_event_t event;
+        button_matrix_events_get(&event);
+        if (event.type != BUTTON_MATRIX_EVENT_PRESS) {
+            continue;
+        }
+
+        switch (1U << event.button) {
+        case BUTTON_A:
+            show_date();
+            break;
+        case BUTTON_UP:
+            adjust_time(60);
+            break;
+        case BUTTON_DOWN:
+            adjust_time(-60);
+            break;
+        case BUTTON_RIGHT:
+            adjust_time(1);
+            break;
+        case BUTTON_LEFT:
+            adjust_time(-1);
+            break;
+        default:
+            continue;
+        }
+
+        show_time();
+    }
+}
+
+static void run_scroll(void)
+{
+    int shown = -1;
+
+    while (1) {
+        struct tm now;
+        char text[sizeof("23:59")];
+
+        rtc_get_time(&now);
+        if ((now.tm_min != shown) && (shown >= 0)) {
+            print_stats();
+        }
+        shown = now.tm_min;
+
+        size_t len = fmt_u32_dec(text, now.tm_hour);
+        text[len++] = ':';
+        text[len++] = '0' + now.tm_min / 10;
+        text[len++] = '0' + now.tm_min % 10;
+        led_matrix_text_scroll(&bitmap_font_matrix_light8, text, len, LED_MATRIX_BRIGHTNESS_MAX);
+        renders += LED_MATRIX_WIDTH + bitmap_font_render_width(&bitmap_font_matrix_light8, text, len);
+    }
+}
+
+int main(void)
+{
+    int retval;
+
+    retval = led_matrix_init();
+    assert(retval == 0);
+
+    retval = button_matrix_init();
+    assert(retval == 0);
+    (void)retval;
+
+    rtc_init_time();
+
+    if (CONFIG_CLOCK_SCROLL) {
+        run_scroll();
+    }
+    else {
+        run_face();
+    }
+
+    return 0;
+}
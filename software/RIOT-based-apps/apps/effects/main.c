@@ -0,0 +1,91 @@
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "button_matrix.h"
+#include "button_matrix_events.h"
+#include "container.h"
+#include "led_matrix.h"
+#include "led_matrix_effects.h"
+
+#if BENCH
+#include "led_matrix_bench.h"
+#endif
+
+/* about 10 seconds per effect */
+#define FRAMES_PER_EFFECT   600
+
+static const led_matrix_effect_t * const effects[] = {
+    &led_matrix_effect_plasma,
+    &led_matrix_effect_fire,
+    &led_matrix_effect_starfield,
+    &led_matrix_effect_ripple,
+};
+
+static led_matrix_effects_state_t state;
+
+#if BENCH
+#define BENCH_FRAMES        1024    /**< Frames to render per effect */
+
+static void bench(const led_matrix_effect_t *effect)
+{
+    led_matrix_bench_t bench;
+
+    if (effect->init) {
+        effect->init(&state, 1);
+    }
+
+    led_matrix_bench_init(&bench);
+    for (uint32_t t = 0; t < BENCH_FRAMES; t++) {
+        led_matrix_bench_begin(&bench);
+        effect->render(&state, t);
+        led_matrix_bench_end(&bench);
+    }
+
+    led_matrix_bench_print(&bench, effect->name, "frame");
+}
+#endif /* BENCH */
+
+int main(void)
+{
+    int retval;
+
+    retval = led_matrix_init();
+    assert(retval == 0);
+
+    retval = button_matrix_init();
+    assert(retval == 0);
+    (void)retval;
+
+#if BENCH
+    for (unsigned i = 0; i < ARRAY_SIZE(effects); i++) {
+        bench(effects[i]);
+    }
+    led_matrix_bench_done();
+#endif
+
+    uint32_t frame = led_matrix_frame_number();
+    unsigned current = 0;
+
+    while (1) {
+        const led_matrix_effect_t *effect = effects[current];
+        uint32_t until = frame + FRAMES_PER_EFFECT;
+
+        if (effect->init) {
+            effect->init(&state, frame);
+        }
+
+        while ((int32_t)(until - frame) > 0) {
+            effect->render(&state, frame);
+            frame = led_matrix_fb_switch(frame) + 1;
+
+            if (button_matrix_events_pressed()) {
+                break;
+            }
+        }
+
+        current = (current + 1) % ARRAY_SIZE(effects);
+    }
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "flash_kv.h"
+#include "flash_kv_sim.h"
+
+#define KEYS        4       /**< Number of keys written, from FLASH_KV_KEY_TEST on */
+#define SETS        1000    /**< Number of values written in the sequence */
+
+struct value {
+    uint8_t data[CONFIG_FLASH_KV_VALUE_MAX];
+    uint8_t len;
+    bool set;
+};
+
+static struct value model[KEYS];
+
+static uint32_t xorshift32(uint32_t x)
+{
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+/* the i-th value of the sequence, mostly short ones as for scores */
+static unsigned sequence_value(unsigned i, struct value *v)
+{
+    uint32_t rnd = xorshift32(i + 1);
+    unsigned key = rnd % KEYS;
+
+    rnd = xorshift32(rnd);
+    v->len = (rnd & 0x3) ? 4 : (rnd >> 8) % (CONFIG_FLASH_KV_VALUE_MAX + 1);
+    for (unsigned j = 0; j < v->len; j++) {
+        rnd = xorshift32(rnd);
+        v->data[j] = rnd;
+    }
+    v->set = true;
+
+    return key;
+}
+
+static bool matches(unsigned key, const struct value *v)
+{
+    uint8_t buf[CONFIG_FLASH_KV_VALUE_MAX];
+    ssize_t len = flash_kv_get(FLASH_KV_KEY_TEST + key, buf, sizeof(buf));
+
+    if (!v->set) {
+        return len == -ENOENT;
+    }
+
+    return (len == v->len) && !memcmp(buf, v->data, v->len);
+}
+
+/* write the sequence from value first on, returns the number of the value
+ * being written when power was lost or SETS */
+static unsigned run(unsigned first)
+{
+    for (unsigned i = first; i < SETS; i++) {
+        struct value v;
+        unsigned key = sequence_value(i, &v);
+        int retval = flash_kv_set(FLASH_KV_KEY_TEST + key, v.data, v.len);
+        if (flash_kv_sim_power_lost()) {
+            return i;
+        }
+        if (retval != 0) {
+            printf("set %u failed: %d\n", i, retval);
+            return SETS;
+        }
+        model[key] = v;
+    }
+
+    return SETS;
+}
+
+static bool check_all(const char *when, uint32_t cut)
+{
+    for (unsigned key = 0; key < KEYS; key++) {
+        if (!matches(key, &model[key])) {
+            printf("cut %u: key %u wrong %s\n", (unsigned)cut, key, when);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool test_cut(uint32_t cut)
+{
+    flash_kv_sim_reset();
+    memset(model, 0, sizeof(model));
+    flash_kv_sim_cut_at(cut);
+    flash_kv_init();
+
+    unsigned lost_at = run(0);
+
+    /* reboot */
+    flash_kv_sim_power_on();
+    if (flash_kv_init() != 0) {
+        printf("cut %u: mount failed\n", (unsigned)cut);
+        return false;
+    }
+
+    if (lost_at < SETS) {
+        /* the value being written may or may not have made it */
+        struct value v;
+        unsigned key = sequence_value(lost_at, &v);
+        if (matches(key, &v)) {
+            model[key] = v;
+        }
+        lost_at++;
+    }
+
+    if (!check_all("after recovery", cut)) {
+        return false;
+    }
+
+    run(lost_at);
+    return check_all("at the end", cut);
+}
+
+int main(void)
+{
+    /* reference run, counting the flash operations */
+    flash_kv_sim_reset();
+    flash_kv_init();
+    run(0);
+    uint32_t ops = flash_kv_sim_ops();
+    if (!check_all("without power loss", FLASH_KV_SIM_NO_CUT)) {
+        return 1;
+    }
+    printf("sets: %u, flash ops: %u, erases: %u + %u\n", (unsigned)SETS, (unsigned)ops,
+           (unsigned)flash_kv_sim_erases(0), (unsigned)flash_kv_sim_erases(1));
+
+    for (uint32_t cut = 0; cut < ops; cut++) {
+        if (!test_cut(cut)) {
+            puts("flash_kv: FAILED");
+            return 1;
+        }
+    }
+
+    printf("flash_kv: %u cut points recovered\n", (unsigned)ops);
+    return 0;
+}
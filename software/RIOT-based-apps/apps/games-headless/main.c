@@ -0,0 +1,103 @@
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "button_matrix.h"
+#include "button_matrix_events.h"
+#include "button_matrix_params.h"
+#include "button_matrix_script.h"
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+#include "periph/pm.h"
+#include "ztimer.h"
+
+#ifndef RUNS
+#  define RUNS                  1000
+#endif
+
+#define SCRIPT_PRESSES          256
+
+struct game {
+    const char *name;
+    void (*run)(void);
+};
+
+static const struct game games[] = {
+    {
+        .name = "flappy_led",
+        .run = led_matrix_games_flappy_led,
+    },
+    {
+        .name = "ledmon_says",
+        .run = led_matrix_games_ledmon_says,
+    },
+};
+
+static const uint8_t buttons[] = {
+    BUTTON_UP, BUTTON_DOWN, BUTTON_LEFT, BUTTON_RIGHT, BUTTON_A, BUTTON_B,
+};
+
+static button_matrix_script_step_t steps[2 * SCRIPT_PRESSES];
+static uint32_t seed;
+
+static const led_matrix_games_replay_t replay = {
+    .seeds = &seed,
+    .steps = steps,
+    .seeds_numof = 1,
+    .steps_numof = ARRAY_SIZE(steps),
+};
+
+/* Random presses of random buttons, derived only from the run number so
+ * that every build plays the very same games */
+static void generate_run(uint32_t run)
+{
+    uint32_t rnd = xorshift32(run + 1);
+    uint32_t frame = 0;
+
+    seed = rnd;
+    for (unsigned i = 0; i < SCRIPT_PRESSES; i++) {
+        rnd = xorshift32(rnd);
+        frame += 3 + (rnd & 0x1f);
+        steps[2 * i].frame = frame;
+        steps[2 * i].scan = buttons[(rnd >> 8) % ARRAY_SIZE(buttons)];
+        frame += 2 + ((rnd >> 16) & 0x7);
+        steps[2 * i + 1].frame = frame;
+        steps[2 * i + 1].scan = 0;
+    }
+}
+
+int main(void)
+{
+    int retval;
+
+    retval = led_matrix_init();
+    assert(retval == 0);
+
+    retval = button_matrix_init();
+    assert(retval == 0);
+    (void)retval;
+
+    for (unsigned g = 0; g < ARRAY_SIZE(games); g++) {
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        uint32_t start_frame = led_matrix_frame_number();
+        uint32_t hash = 0;
+
+        for (uint32_t run = 0; run < RUNS; run++) {
+            generate_run(run);
+            button_matrix_events_flush();
+            led_matrix_headless_hash_reset();
+            led_matrix_games_replay_start(&replay);
+            games[g].run();
+            /* combine the runs order dependent */
+            hash = xorshift32(hash ^ led_matrix_headless_hash());
+        }
+
+        uint32_t us = ztimer_now(ZTIMER_USEC) - start;
+        uint32_t frames = led_matrix_frame_number() - start_frame;
+        printf("%s: %u runs, %" PRIu32 " frames in %" PRIu32 " us, hash %08" PRIx32 "\n",
+               games[g].name, (unsigned)RUNS, frames, us, hash);
+    }
+
+    pm_off();
+    return 0;
+}
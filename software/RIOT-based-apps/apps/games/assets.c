@@ -0,0 +1,18 @@
+/* This file is auto generated using assets2c.py */
+#include <stdint.h>
+#include "bitmap_fonts.h"
+
+static const uint8_t _msg_menu[] = {
+    0x7e, 0x01, 0x0e, 0x01, 0x7e, 0x00, 0x38, 0x54,
+    0x48, 0x00, 0x7c, 0x04, 0x78, 0x00, 0x3c, 0x40,
+    0x7c,
+};
+
+const bitmap_glyph_t msg_menu = {
+    .data = _msg_menu,
+    .width = 17,
+    .height = 8,
+    .bytes_per_column = 1,
+};
+
+/* asset data: 17 bytes */
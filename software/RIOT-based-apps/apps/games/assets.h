@@ -0,0 +1,17 @@
+/* This file is auto generated using assets2c.py */
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "bitmap_fonts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const bitmap_glyph_t msg_menu; /**< Pre-rendered 'Menu' */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASSETS_H */
@@ -2,16 +2,25 @@
 #include <string.h>
 
 #include "board.h"
+#include "assets.h"
 #include "button_matrix.h"
+#include "button_matrix_events.h"
+#include "button_matrix_params.h"
 #include "led_matrix.h"
 #include "led_matrix_games.h"
 #include "led_matrix_params.h"
+#include "led_matrix_tasks.h"
 
 struct game {
     const char *name;
     void (*run)(void);
 };
 
+#if MODULE_LED_MATRIX_GAMES_REPLAY
+/* provided by replay.c, as printed in record mode */
+extern const led_matrix_games_replay_t games_replay;
+#endif
+
 const struct game games[] = {
     {
         .name = "Flappy LED",
@@ -21,72 +30,126 @@ const struct game games[] = {
         .name = "LEDmon says",
         .run = led_matrix_games_ledmon_says,
     },
+    {
+        .name = "Game of Life",
+        .run = led_matrix_games_life,
+    },
 };
 
-int main(void)
+static led_matrix_tasks_scroll_t name_scroll;
+static led_matrix_task_t menu_task;
+static uint8_t game_idx;
+
+static void show_name(void)
 {
-    int retval;
+    const char *name = games[game_idx].name;
+    led_matrix_tasks_scroll(&name_scroll, &bitmap_font_matrix_light8, name, strlen(name),
+                            LED_MATRIX_BRIGHTNESS_MAX);
+}
 
-    retval = led_matrix_init();
-    assert(retval == 0);
+static void draw_arrow(const bitmap_glyph_t *arrow)
+{
+    led_matrix_fb_clear();
+    led_matrix_glyph(arrow,
+                     (LED_MATRIX_WIDTH - arrow->width) / 2,
+                     (LED_MATRIX_HEIGHT - arrow->height) / 2,
+                     LED_MATRIX_BRIGHTNESS_MAX);
+}
 
-    retval = button_matrix_init();
-    assert(retval == 0);
-    (void)retval;
+static bool buttons_released(void)
+{
+    uint8_t state[LED_MATRIX_GAMES_BTN_BYTES];
+    static const uint8_t released[LED_MATRIX_GAMES_BTN_BYTES];
 
-    uint8_t game_idx = 0;
-    const uint8_t btns = BUTTON_UP | BUTTON_DOWN | BUTTON_A;
-    static const char msg_menu[] = "Menu";
+    button_matrix_events_state(state);
+    return !memcmp(state, released, sizeof(state));
+}
+
+/* reacts to the buttons right away, while the name of the selected game
+ * keeps scrolling in the name_scroll task */
+static int menu(led_matrix_task_t *t)
+{
+    static const uint8_t btns[] = { BUTTON_UP | BUTTON_DOWN | BUTTON_A };
 
-    led_matrix_text_scroll(&bitmap_font_matrix_light8, msg_menu, sizeof(msg_menu) - 1,
-                           LED_MATRIX_BRIGHTNESS_MAX);
+    LED_MATRIX_TASK_BEGIN(t);
+    show_name();
     while (1) {
-        const struct game *game = &games[game_idx];
-        size_t len = strlen(game->name);
-        uint8_t btns_pressed;
-        led_matrix_text_scroll_until_button(&bitmap_font_matrix_light8, game->name, len,
-                                            &btns, &btns_pressed, sizeof(btns_pressed),
-                                            LED_MATRIX_BRIGHTNESS_MAX);
-
-        led_matrix_fb_clear();
-
-        if (btns_pressed & BUTTON_A) {
-            /* wait for button to be released before starting the game */
-            do {
-                button_matrix_scan(&btns_pressed);
-            } while (btns_pressed);
-
-            while (1) {
-                game->run();
-            }
+        LED_MATRIX_TASK_WAIT_BUTTON(t, btns);
+        if (t->event.type != BUTTON_MATRIX_EVENT_PRESS) {
+            continue;
+        }
+
+        led_matrix_task_stop(&name_scroll.task);
+        /* the scroll task may have left a switch pending, drawing now would
+         * alter the frame about to be shown */
+        LED_MATRIX_TASK_WAIT_UNTIL(t, led_matrix_fb_switch_done(NULL));
+        uint8_t btn = 1U << t->event.button;
+
+        if (btn == BUTTON_A) {
+            led_matrix_fb_clear();
+            LED_MATRIX_TASK_FB_SWITCH(t, led_matrix_frame_number(), NULL);
+            LED_MATRIX_TASK_EXIT(t);
         }
 
-        if (btns_pressed & BUTTON_UP) {
+        if (btn == BUTTON_UP) {
             game_idx--;
             if (game_idx >= ARRAY_SIZE(games)) {
                 game_idx = ARRAY_SIZE(games) - 1;
             }
-            led_matrix_glyph(&bitmap_glyph_arrow_up,
-                             (LED_MATRIX_WIDTH - bitmap_glyph_arrow_up.width) / 2,
-                             (LED_MATRIX_HEIGHT - 8) / 2,
-                             LED_MATRIX_BRIGHTNESS_MAX);
+            draw_arrow(&bitmap_glyph_arrow_up);
         }
         else {
             game_idx++;
             if (game_idx >= ARRAY_SIZE(games)) {
                 game_idx = 0;
             }
-            led_matrix_glyph(&bitmap_glyph_arrow_down,
-                             (LED_MATRIX_WIDTH - bitmap_glyph_arrow_up.width) / 2,
-                             (LED_MATRIX_HEIGHT - 8) / 2,
-                             LED_MATRIX_BRIGHTNESS_MAX);
+            draw_arrow(&bitmap_glyph_arrow_down);
         }
 
-        led_matrix_fb_switch(led_matrix_frame_number());
+        LED_MATRIX_TASK_FB_SWITCH(t, led_matrix_frame_number(), NULL);
+        LED_MATRIX_TASK_WAIT_UNTIL(t, buttons_released());
+        show_name();
+    }
+    LED_MATRIX_TASK_END(t);
+}
+
+int main(void)
+{
+    int retval;
+
+    retval = led_matrix_init();
+    assert(retval == 0);
+
+    retval = button_matrix_init();
+    assert(retval == 0);
+    (void)retval;
+
+#if MODULE_LED_MATRIX_GAMES_RECORD || MODULE_LED_MATRIX_GAMES_REPLAY
+    /* start right after a frame switch, so that the replay has the same
+     * phase relative to the game loops as the recording */
+    led_matrix_fb_switch(led_matrix_frame_number());
+#endif
+#if MODULE_LED_MATRIX_GAMES_RECORD
+    led_matrix_games_record_start();
+#endif
+#if MODULE_LED_MATRIX_GAMES_REPLAY
+    led_matrix_games_replay_start(&games_replay);
+#endif
+
+    led_matrix_image_scroll(&msg_menu, LED_MATRIX_BRIGHTNESS_MAX);
+
+    /* returns once a game was chosen */
+    led_matrix_task_start(&menu_task, menu, NULL);
+    led_matrix_tasks_run();
 
-        /* wait for the user to release the button */
-        do {
-            button_matrix_scan(&btns_pressed);
-        } while (btns_pressed);
+    /* wait for button to be released before starting the game */
+    button_matrix_events_wait_for_release();
+
+    const struct game *game = &games[game_idx];
+    while (1) {
+        game->run();
+#if MODULE_LED_MATRIX_GAMES_RECORD
+        led_matrix_games_record_print("games_replay");
+#endif
     }
 }
@@ -0,0 +1,67 @@
+#include <assert.h>
+#include <stdio.h>
+
+#include "button_matrix.h"
+#include "button_matrix_params.h"
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+#include "led_matrix_latency.h"
+
+#if MODULE_BUTTON_MATRIX_SCRIPT
+#include "button_matrix_script.h"
+#include "periph/pm.h"
+
+#define SCRIPT_PRESSES          128     /**< Number of presses in the script */
+#define SCRIPT_PRESS_FRAMES     3       /**< Duration of a press in frames */
+
+static button_matrix_script_step_t script[2 * SCRIPT_PRESSES];
+
+static void script_init(void)
+{
+    /* Keep flapping at an irregular pace, so that the presses hit different
+     * phases of the game loop */
+    uint32_t frame = 60;
+    for (unsigned i = 0; i < SCRIPT_PRESSES; i++) {
+        script[2 * i].frame = frame;
+        script[2 * i].scan = BUTTON_A;
+        script[2 * i + 1].frame = frame + SCRIPT_PRESS_FRAMES;
+        script[2 * i + 1].scan = 0;
+        frame += 17 + (i % 5);
+    }
+}
+#endif
+
+int main(void)
+{
+    int retval;
+
+    retval = led_matrix_init();
+    assert(retval == 0);
+
+    retval = button_matrix_init();
+    assert(retval == 0);
+    (void)retval;
+
+#if MODULE_BUTTON_MATRIX_SCRIPT
+    script_init();
+    /* start the script right after a frame switch, so that the phase
+     * between the script and the game loop is the same on every run */
+    led_matrix_fb_switch(led_matrix_frame_number());
+    button_matrix_script_start(script, ARRAY_SIZE(script));
+
+    /* Every scripted press either starts a game or is played in one, so
+     * this terminates */
+    while (!button_matrix_script_done()) {
+        led_matrix_games_flappy_led();
+        led_matrix_latency_print();
+    }
+    pm_off();
+#else
+    while (1) {
+        led_matrix_games_flappy_led();
+        led_matrix_latency_print();
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "button_matrix.h"
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+#include "led_matrix_params.h"
+
+#if BENCH
+#include "led_matrix_bench.h"
+
+#define BENCH_SEEDS         256     /**< Boards to compare the kernel with the reference on */
+#define BENCH_GENERATIONS   64      /**< Generations per board */
+
+/* the straightforward way: count the neighbors of every cell one by one */
+static bool reference_step(led_matrix_games_life_t *life)
+{
+    uint16_t next[LED_MATRIX_WIDTH] = { 0 };
+
+    for (int x = 0; x < (int)LED_MATRIX_WIDTH; x++) {
+        for (int y = 0; y < (int)LED_MATRIX_HEIGHT; y++) {
+            unsigned neighbors = 0;
+            for (int dx = -1; dx <= 1; dx++) {
+                for (int dy = -1; dy <= 1; dy++) {
+                    if (!dx && !dy) {
+                        continue;
+                    }
+                    unsigned nx = (x + dx + LED_MATRIX_WIDTH) % LED_MATRIX_WIDTH;
+                    unsigned ny = (y + dy + LED_MATRIX_HEIGHT) % LED_MATRIX_HEIGHT;
+                    neighbors += (life->cells.cols[nx] >> ny) & 1;
+                }
+            }
+            bool alive = (life->cells.cols[x] >> y) & 1;
+            if ((neighbors == 3) || (alive && (neighbors == 2))) {
+                next[x] |= 1U << y;
+            }
+        }
+    }
+
+    memcpy(life->cells.cols, next, sizeof(next));
+    return false;
+}
+
+static void check(void)
+{
+    for (uint32_t seed = 1; seed <= BENCH_SEEDS; seed++) {
+        led_matrix_games_life_t kernel, reference;
+        led_matrix_games_life_seed(&kernel, seed);
+        led_matrix_games_life_seed(&reference, seed);
+        for (unsigned i = 0; i < BENCH_GENERATIONS; i++) {
+            led_matrix_games_life_step(&kernel);
+            reference_step(&reference);
+            if (memcmp(&kernel.cells, &reference.cells, sizeof(kernel.cells))) {
+                printf("mismatch: seed %" PRIu32 ", generation %u\n", seed, i + 1);
+                return;
+            }
+        }
+    }
+
+    printf("kernel matches reference on %u boards\n", BENCH_SEEDS);
+}
+
+static void bench(const char *name, bool (*step)(led_matrix_games_life_t *))
+{
+    led_matrix_games_life_t life;
+    led_matrix_bench_t bench;
+
+    led_matrix_bench_init(&bench);
+    for (uint32_t seed = 1; seed <= BENCH_SEEDS; seed++) {
+        led_matrix_games_life_seed(&life, seed);
+        for (unsigned i = 0; i < BENCH_GENERATIONS; i++) {
+            led_matrix_bench_begin(&bench);
+            step(&life);
+            led_matrix_bench_end(&bench);
+        }
+    }
+
+    led_matrix_bench_print(&bench, name, "generation");
+}
+#endif /* BENCH */
+
+int main(void)
+{
+    int retval;
+
+    retval = led_matrix_init();
+    assert(retval == 0);
+
+    retval = button_matrix_init();
+    assert(retval == 0);
+    (void)retval;
+
+#if BENCH
+    check();
+    bench("kernel", led_matrix_games_life_step);
+    bench("reference", reference_step);
+    led_matrix_bench_done();
+#endif
+
+    while (1) {
+        led_matrix_games_life();
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <assert.h>
+
+#include "container.h"
+#include "fmt.h"
+#include "led_matrix.h"
+#include "led_matrix_params.h"
+#include "led_matrix_queue.h"
+#include "mutex.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define HEARTBEAT_X     (LED_MATRIX_WIDTH - 1)
+#define HEARTBEAT_Y     0
+
+static char heartbeat_stack[THREAD_STACKSIZE_SMALL];
+/* also redrawn by main, as clearing the frame wipes it. Reading or toggling
+ * the brightness and submitting the pixel is done with heartbeat_lock held,
+ * so that the queue gets the pixel values in the order they were set */
+static mutex_t heartbeat_lock = MUTEX_INIT;
+static uint8_t heartbeat_brightness;
+
+static void *heartbeat(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        mutex_lock(&heartbeat_lock);
+        heartbeat_brightness ^= LED_MATRIX_BRIGHTNESS_MAX;
+        const led_matrix_cmd_t cmds[] = {
+            led_matrix_cmd_pixel(HEARTBEAT_X, HEARTBEAT_Y, heartbeat_brightness),
+            led_matrix_cmd_present(led_matrix_frame_number()),
+        };
+        led_matrix_queue_submit(cmds, ARRAY_SIZE(cmds));
+        mutex_unlock(&heartbeat_lock);
+        ztimer_sleep(ZTIMER_MSEC, 500);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    int retval = led_matrix_init();
+    assert(retval == 0);
+    (void)retval;
+
+    thread_create(heartbeat_stack, sizeof(heartbeat_stack), THREAD_PRIORITY_MAIN + 1, 0,
+                  heartbeat, NULL, "heartbeat");
+
+    char text[2];
+    for (unsigned seconds = 0; ; seconds = (seconds + 1) % 100) {
+        /* the text is referenced by the command, not copied */
+        led_matrix_queue_flush();
+        size_t len = fmt_u32_dec(text, seconds);
+        mutex_lock(&heartbeat_lock);
+        const led_matrix_cmd_t cmds[] = {
+            led_matrix_cmd_clear(),
+            led_matrix_cmd_text(&bitmap_font_tiny5, text, len, 1, 2,
+                                LED_MATRIX_BRIGHTNESS_MAX),
+            led_matrix_cmd_pixel(HEARTBEAT_X, HEARTBEAT_Y, heartbeat_brightness),
+            led_matrix_cmd_present(led_matrix_frame_number()),
+        };
+        led_matrix_queue_submit(cmds, ARRAY_SIZE(cmds));
+        mutex_unlock(&heartbeat_lock);
+        ztimer_sleep(ZTIMER_MSEC, 1000);
+    }
+
+    return 0;
+}
@@ -23,6 +23,9 @@
 #include "periph_conf.h"
 #include "periph_cpu.h"
 
+/* button coordinates and masks, shared with the scripted button matrix */
+#include "business_card_buttons.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -51,50 +54,26 @@ extern "C" {
  * @{
  */
 #define BUTTON_MATRIX_PORT              GPIO_PORT_B     /**< The GPIO port the button matrix connected to */
+#define BUTTON_MATRIX_EVENTS_TIMER      TIMER_DEV(1)    /**< Timer to use for background scanning */
 
 #define BUTTON_MATRIX_PIN_0             7               /**< GPIO pin number of button matrix pin 0 */
 #define BUTTON_MATRIX_PIN_1             4               /**< GPIO pin number of button matrix pin 1 */
 #define BUTTON_MATRIX_PIN_2             0               /**< GPIO pin number of button matrix pin 2 */
 
-/* for button_matrix_test() */
-#define BUTTON_MATRIX_COORD_UP          0,0     /**< Button matrix coordinates of the up button */
-#define BUTTON_MATRIX_COORD_DOWN        0,1     /**< Button matrix coordinates of the up button */
-#define BUTTON_MATRIX_COORD_LEFT        1,0     /**< Button matrix coordinates of the left button */
-#define BUTTON_MATRIX_COORD_RIGHT       1,2     /**< Button matrix coordinates of the right button */
-#define BUTTON_MATRIX_COORD_A           2,1     /**< Button matrix coordinates of the "A" button */
-#define BUTTON_MATRIX_COORD_B           2,2     /**< Button matrix coordinates of the "B" button */
-
-/* for button_matrix_scan() */
-#define BUTTON_UP       0x01    /**< Bitmask to check for the up button */
-#define BUTTON_LEFT     0x02    /**< Bitmask to check for the left button */
-#define BUTTON_DOWN     0x04    /**< Bitmask to check for the down button */
-#define BUTTON_A        0x08    /**< Bitmask to check for the "A" button */
-#define BUTTON_RIGHT    0x10    /**< Bitmask to check for the right button */
-#define BUTTON_B        0x20    /**< Bitmask to check for the "B" button */
-
-/**
- * @brief   Bitmask with bits for each and every button available on this board set
- */
-static const uint8_t board_btns_all[] = {
-    BUTTON_A | BUTTON_B | BUTTON_UP | BUTTON_DOWN | BUTTON_LEFT | BUTTON_RIGHT
-};
-
 /**
  * @brief   Heuristic to filter out fake inputs due to rollover
  *
- * The currently implemented heuristic assumes that at most two buttons are
- * pressed at the same time. E.g. pressing both up and right button will
- * result in a ghost reading for button left. So when up, right, and left
- * are enabled, it will assume that in fact only up and right are pressed
- * and left is a ghost input, which is trimmed.
+ * E.g. pressing both up and right button will result in a ghost reading for
+ * button left. So when up, right, and left are enabled, it will assume that
+ * in fact only up and right are pressed and left is a ghost input, which is
+ * trimmed.
  *
- * As long as indeed only two buttons are pressed at the same time, this
- * simple heuristic is sufficient. More sophisticated heuristics are
- * certainly possible that e.g. track the state over time. But
- * 2-key-rollover seems to be good enough for most games.
+ * This is a wrapper for @ref button_matrix_remove_ghosts, which derives the
+ * ghost readings from the wiring of the button matrix. As long as at most
+ * two buttons are pressed at the same time, the result is exact.
  *
  * @param[in]   scan    The output of button_matrix_scan()
- * @returl  The bitmask without rollover artifacts
+ * @return  The bitmask without rollover artifacts
  */
 uint8_t compensate_rollover(uint8_t scan);
 /** @} */
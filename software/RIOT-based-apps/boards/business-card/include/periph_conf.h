@@ -40,11 +40,20 @@ static const timer_conf_t timer_config[] = {
         .rcc_mask = RCC_APBENR2_TIM1EN,
         .bus      = APB12,
         .irqn     = TIM1_CC_IRQn
+    },
+    {
+        .dev      = TIM3,
+        .max      = 0x0000ffff,
+        .rcc_mask = RCC_APBENR1_TIM3EN,
+        .bus      = APB1,
+        .irqn     = TIM3_IRQn
     }
 };
 
 #define TIMER_0_ISR         isr_tim1_cc
 #define TIMER_0_MAX_VALUE   0xffff
+#define TIMER_1_ISR         isr_tim3
+#define TIMER_1_MAX_VALUE   0xffff
 
 #define TIMER_NUMOF         ARRAY_SIZE(timer_config)
 /** @} */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     boards_business_card
+ * @{
+ *
+ * @file
+ * @brief       Button layout of the business card
+ *
+ * Included by the board and, via button_matrix_params.h, by the scripted
+ * button matrix on boards without the real hardware (e.g. native), so that
+ * both agree on the button masks.
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef BUSINESS_CARD_BUTTONS_H
+#define BUSINESS_CARD_BUTTONS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* for button_matrix_test() */
+#define BUTTON_MATRIX_COORD_UP          0,0     /**< Button matrix coordinates of the up button */
+#define BUTTON_MATRIX_COORD_DOWN        0,1     /**< Button matrix coordinates of the up button */
+#define BUTTON_MATRIX_COORD_LEFT        1,0     /**< Button matrix coordinates of the left button */
+#define BUTTON_MATRIX_COORD_RIGHT       1,2     /**< Button matrix coordinates of the right button */
+#define BUTTON_MATRIX_COORD_A           2,1     /**< Button matrix coordinates of the "A" button */
+#define BUTTON_MATRIX_COORD_B           2,2     /**< Button matrix coordinates of the "B" button */
+
+/* for button_matrix_scan() */
+#define BUTTON_UP       0x01    /**< Bitmask to check for the up button */
+#define BUTTON_LEFT     0x02    /**< Bitmask to check for the left button */
+#define BUTTON_DOWN     0x04    /**< Bitmask to check for the down button */
+#define BUTTON_A        0x08    /**< Bitmask to check for the "A" button */
+#define BUTTON_RIGHT    0x10    /**< Bitmask to check for the right button */
+#define BUTTON_B        0x20    /**< Bitmask to check for the "B" button */
+
+/**
+ * @brief   Bitmask with bits for each and every button available on this board set
+ */
+static const uint8_t board_btns_all[] = {
+    BUTTON_A | BUTTON_B | BUTTON_UP | BUTTON_DOWN | BUTTON_LEFT | BUTTON_RIGHT
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUSINESS_CARD_BUTTONS_H */
+/** @} */
@@ -42,24 +42,29 @@ static const uint8_t bitmap_data[] = {
     0x44, 0x3c, 0x40, 0x7c, 0x1c, 0x60, 0x1c, 0x3c,
     0x40, 0x3c, 0x40, 0x3c, 0x6c, 0x10, 0x6c, 0x1c,
     0xa0, 0x7c, 0x64, 0x54, 0x4c, 0x08, 0x77, 0x41,
-    0x7f, 0x41, 0x77, 0x08,
+    0x7f, 0x41, 0x77, 0x08, 0x10, 0x08, 0x10, 0x08,
+};
+
+static const uint16_t bitmap_offsets[] = {
+    0x0000, 0x0003, 0x0004, 0x0007, 0x000c, 0x000f, 0x0012, 0x0016,
+    0x0017, 0x0019, 0x001b, 0x001f, 0x0022, 0x0023, 0x0026, 0x0027,
+    0x002a, 0x002d, 0x002f, 0x0032, 0x0035, 0x0038, 0x003b, 0x003e,
+    0x0041, 0x0044, 0x0047, 0x0048, 0x0049, 0x004c, 0x004f, 0x0052,
+    0x0055, 0x0059, 0x005c, 0x005f, 0x0062, 0x0065, 0x0068, 0x006b,
+    0x006f, 0x0073, 0x0074, 0x0077, 0x007a, 0x007d, 0x0082, 0x0086,
+    0x008a, 0x008d, 0x0091, 0x0094, 0x0097, 0x009a, 0x009d, 0x00a0,
+    0x00a5, 0x00a8, 0x00ab, 0x00ae, 0x00b1, 0x00b4, 0x00b7, 0x00ba,
+    0x00bd, 0x00bf, 0x00c2, 0x00c5, 0x00c8, 0x00cb, 0x00ce, 0x00d1,
+    0x00d4, 0x00d7, 0x00d8, 0x00db, 0x00de, 0x00df, 0x00e4, 0x00e7,
+    0x00ea, 0x00ed, 0x00f0, 0x00f3, 0x00f6, 0x00f9, 0x00fc, 0x00ff,
+    0x0104, 0x0107, 0x010a, 0x010d, 0x0110, 0x0111, 0x0114, 0x0118,
 };
 
 const bitmap_font_t bitmap_font_matrix_light8 = {
-    .data_size = 0x0114,
     .data = bitmap_data,
-    .offsets = {
-        0x0000, 0x0003, 0x0004, 0x0007, 0x000c, 0x000f, 0x0012, 0x0016,
-        0x0017, 0x0019, 0x001b, 0x001f, 0x0022, 0x0023, 0x0026, 0x0027,
-        0x002a, 0x002d, 0x002f, 0x0032, 0x0035, 0x0038, 0x003b, 0x003e,
-        0x0041, 0x0044, 0x0047, 0x0048, 0x0049, 0x004c, 0x004f, 0x0052,
-        0x0055, 0x0059, 0x005c, 0x005f, 0x0062, 0x0065, 0x0068, 0x006b,
-        0x006f, 0x0073, 0x0074, 0x0077, 0x007a, 0x007d, 0x0082, 0x0086,
-        0x008a, 0x008d, 0x0091, 0x0094, 0x0097, 0x009a, 0x009d, 0x00a0,
-        0x00a5, 0x00a8, 0x00ab, 0x00ae, 0x00b1, 0x00b4, 0x00b7, 0x00ba,
-        0x00bd, 0x00bf, 0x00c2, 0x00c5, 0x00c8, 0x00cb, 0x00ce, 0x00d1,
-        0x00d4, 0x00d7, 0x00d8, 0x00db, 0x00de, 0x00df, 0x00e4, 0x00e7,
-        0x00ea, 0x00ed, 0x00f0, 0x00f3, 0x00f6, 0x00f9, 0x00fc, 0x00ff,
-        0x0104, 0x0107, 0x010a, 0x010d, 0x0110, 0x0111,
-    },
+    .offsets = bitmap_offsets,
+    .height = 8,
+    .bytes_per_column = 1,
 };
+
+/* font data: 472 bytes */
@@ -0,0 +1,76 @@
+/* This file is auto generated using bdf2c.py */
+/* SPDX-License-Identifier: MIT
+ * Original Name: MatrixLight8
+ * Original Author: https://github.com/trip5
+ * Upstream Repo: https://github.com/trip5/Matrix-Fonts
+ */
+#include <stdint.h>
+#include "bitmap_fonts.h"
+
+static const uint8_t bitmap_data[] = {
+    0x94, 0xd2, 0xff, 0x56, 0x69, 0x35, 0xc0, 0x00,
+    0x63, 0xff, 0xda, 0x97, 0xf8, 0x73, 0xe1, 0x9f,
+    0x5d, 0x7f, 0x3f, 0x1c, 0x3e, 0x7f, 0xec, 0x8f,
+    0x1d, 0xd4, 0x1a, 0x0a, 0x27, 0xc0, 0x10, 0x82,
+    0x80, 0xa7, 0x96, 0x51, 0xbe, 0x00, 0xf8, 0x72,
+    0xe4, 0x1b, 0x65, 0xa2, 0x3f, 0xc3, 0x57, 0x00,
+    0xff, 0x89, 0xfc, 0x98, 0x42, 0xbe, 0xcc, 0xfa,
+    0x79, 0x58, 0x13, 0x7d, 0x49, 0x31, 0x9f, 0x2c,
+    0x98, 0x6c, 0x8c, 0xc9, 0x26, 0x7c, 0x01, 0xdf,
+    0xca, 0xf0, 0xdf, 0x23, 0xa2, 0x08, 0x88, 0x2e,
+    0x23, 0x83, 0x51, 0x00, 0x21, 0x00, 0xa1, 0x32,
+    0x48, 0x02, 0x21, 0x00, 0xf0, 0x61, 0x04, 0x03,
+    0x41, 0x02, 0x21, 0xe2, 0xfa, 0x0e, 0x2b, 0x02,
+    0x15, 0x40, 0x19, 0xa3, 0x00, 0xd4, 0xca, 0xf8,
+    0x21, 0xdf, 0x0b, 0xa0, 0x6f, 0x77, 0xc9, 0x97,
+    0x59, 0x60, 0x31, 0xc1, 0xfe, 0x07, 0xfc, 0x1f,
+    0x4c, 0x30, 0xc1, 0x64, 0x90, 0x38, 0xe1, 0x1f,
+    0x47, 0xfe, 0x11, 0x18, 0xa3, 0x1e, 0x38, 0x06,
+    0x68, 0xab, 0x09, 0x21, 0xd6, 0x17, 0xf8, 0x20,
+    0x3b, 0x01, 0xf7, 0x9e, 0x73, 0xcf, 0x81, 0xb7,
+    0x3f, 0x52, 0x88, 0xe8, 0x63, 0x7c, 0xd2, 0x09,
+    0x54, 0xfa, 0x7a, 0xe2, 0x03, 0x7e, 0x3d, 0xc0,
+    0x3f, 0x1b, 0x98, 0x2a, 0xa9, 0x34, 0x55, 0x7a,
+    0xee, 0x7d, 0x7e, 0xfb, 0x31, 0x3e, 0x86, 0xfd,
+    0xfc, 0x49, 0xa9, 0x8f, 0xb4, 0xad, 0x62, 0xae,
+    0x8b, 0x79, 0xe0, 0xe9, 0xa2, 0x8b, 0xfe, 0xd9,
+    0xf8, 0x67, 0x3b, 0x1f, 0x74, 0x7e, 0xb2, 0xfd,
+    0x99, 0x82, 0x1c, 0x60, 0xc8, 0xc0, 0x03, 0x0f,
+    0x00,
+};
+
+static const uint8_t bitmap_columns[] = {
+    0x7f, 0x08, 0x40, 0x41, 0x49, 0x3e, 0x14, 0x1c,
+    0x09, 0x78, 0x04, 0x01, 0x3f, 0x06, 0x44, 0x38,
+    0x60, 0x7e, 0x77, 0x7c, 0x00, 0x03, 0x24, 0x26,
+    0x07, 0x22, 0x36, 0x54, 0x10, 0x3c, 0x59,
+};
+
+static const uint8_t bitmap_widths[] = {
+    0x13, 0x53, 0x33, 0x14, 0x22, 0x34, 0x31, 0x31,
+    0x23, 0x33, 0x33, 0x33, 0x33, 0x11, 0x33, 0x33,
+    0x34, 0x33, 0x33, 0x43, 0x14, 0x33, 0x53, 0x44,
+    0x43, 0x33, 0x33, 0x53, 0x33, 0x33, 0x33, 0x33,
+    0x32, 0x33, 0x33, 0x33, 0x13, 0x33, 0x51, 0x33,
+    0x33, 0x33, 0x33, 0x53, 0x33, 0x33, 0x31, 0x04,
+};
+
+static const uint16_t bitmap_anchors[] = {
+    0x0000, 0x00a3, 0x0112, 0x01cd, 0x0241, 0x02cb, 0x0362, 0x0419,
+    0x04a1, 0x053c, 0x05ca, 0x0674,
+};
+
+static const bitmap_font_dict_t bitmap_dict = {
+    .columns = bitmap_columns,
+    .widths = bitmap_widths,
+    .anchors = bitmap_anchors,
+};
+
+const bitmap_font_t bitmap_font_matrix_light8_dict = {
+    .data = bitmap_data,
+    .dict = &bitmap_dict,
+    .height = 8,
+    .bytes_per_column = 1,
+};
+
+/* font data: 328 bytes */
@@ -0,0 +1,65 @@
+/* This file is auto generated using bdf2c.py */
+/* SPDX-License-Identifier: MIT */
+#include <stdint.h>
+#include "bitmap_fonts.h"
+
+static const uint8_t bitmap_data[] = {
+    0x00, 0x00, 0x17, 0x03, 0x00, 0x03, 0x1f, 0x0a,
+    0x1f, 0x12, 0x1f, 0x09, 0x19, 0x04, 0x13, 0x0a,
+    0x15, 0x1a, 0x03, 0x0e, 0x11, 0x11, 0x0e, 0x0a,
+    0x04, 0x0a, 0x04, 0x0e, 0x04, 0x10, 0x08, 0x04,
+    0x04, 0x04, 0x10, 0x18, 0x04, 0x03, 0x1f, 0x11,
+    0x1f, 0x12, 0x1f, 0x10, 0x1d, 0x15, 0x17, 0x11,
+    0x15, 0x1f, 0x07, 0x04, 0x1f, 0x17, 0x15, 0x1d,
+    0x1f, 0x15, 0x1d, 0x01, 0x19, 0x07, 0x1f, 0x15,
+    0x1f, 0x17, 0x15, 0x1f, 0x0a, 0x10, 0x0a, 0x04,
+    0x0a, 0x11, 0x0a, 0x0a, 0x0a, 0x11, 0x0a, 0x04,
+    0x01, 0x15, 0x07, 0x0e, 0x15, 0x16, 0x1e, 0x05,
+    0x1e, 0x1f, 0x15, 0x0a, 0x0e, 0x11, 0x11, 0x1f,
+    0x11, 0x0e, 0x1f, 0x15, 0x11, 0x1f, 0x05, 0x01,
+    0x0e, 0x11, 0x1d, 0x1f, 0x04, 0x1f, 0x11, 0x1f,
+    0x11, 0x08, 0x10, 0x0f, 0x1f, 0x04, 0x1b, 0x1f,
+    0x10, 0x10, 0x1f, 0x06, 0x1f, 0x1f, 0x01, 0x1e,
+    0x0e, 0x11, 0x0e, 0x1f, 0x05, 0x02, 0x0e, 0x19,
+    0x16, 0x1f, 0x05, 0x1a, 0x12, 0x15, 0x09, 0x01,
+    0x1f, 0x01, 0x1f, 0x10, 0x1f, 0x07, 0x18, 0x07,
+    0x1f, 0x0c, 0x1f, 0x1b, 0x04, 0x1b, 0x03, 0x1c,
+    0x03, 0x19, 0x15, 0x13, 0x1f, 0x11, 0x03, 0x04,
+    0x18, 0x11, 0x1f, 0x02, 0x01, 0x02, 0x10, 0x10,
+    0x10, 0x01, 0x02, 0x1e, 0x05, 0x1e, 0x1f, 0x15,
+    0x0a, 0x0e, 0x11, 0x11, 0x1f, 0x11, 0x0e, 0x1f,
+    0x15, 0x11, 0x1f, 0x05, 0x01, 0x0e, 0x11, 0x1d,
+    0x1f, 0x04, 0x1f, 0x11, 0x1f, 0x11, 0x08, 0x10,
+    0x0f, 0x1f, 0x04, 0x1b, 0x1f, 0x10, 0x10, 0x1f,
+    0x06, 0x1f, 0x1f, 0x01, 0x1e, 0x0e, 0x11, 0x0e,
+    0x1f, 0x05, 0x02, 0x0e, 0x19, 0x16, 0x1f, 0x05,
+    0x1a, 0x12, 0x15, 0x09, 0x01, 0x1f, 0x01, 0x1f,
+    0x10, 0x1f, 0x07, 0x18, 0x07, 0x1f, 0x0c, 0x1f,
+    0x1b, 0x04, 0x1b, 0x03, 0x1c, 0x03, 0x19, 0x15,
+    0x13, 0x04, 0x1f, 0x11, 0x1f, 0x11, 0x1f, 0x04,
+    0x04, 0x06, 0x02,
+};
+
+static const uint16_t bitmap_offsets[] = {
+    0x0000, 0x0002, 0x0003, 0x0006, 0x0009, 0x000c, 0x000f, 0x0012,
+    0x0013, 0x0015, 0x0017, 0x001a, 0x001d, 0x001f, 0x0022, 0x0023,
+    0x0026, 0x0029, 0x002c, 0x002f, 0x0032, 0x0035, 0x0038, 0x003b,
+    0x003e, 0x0041, 0x0044, 0x0045, 0x0047, 0x004a, 0x004d, 0x0050,
+    0x0053, 0x0056, 0x0059, 0x005c, 0x005f, 0x0062, 0x0065, 0x0068,
+    0x006b, 0x006e, 0x0071, 0x0074, 0x0077, 0x007a, 0x007d, 0x0080,
+    0x0083, 0x0086, 0x0089, 0x008c, 0x008f, 0x0092, 0x0095, 0x0098,
+    0x009b, 0x009e, 0x00a1, 0x00a4, 0x00a6, 0x00a9, 0x00ab, 0x00ae,
+    0x00b1, 0x00b3, 0x00b6, 0x00b9, 0x00bc, 0x00bf, 0x00c2, 0x00c5,
+    0x00c8, 0x00cb, 0x00ce, 0x00d1, 0x00d4, 0x00d7, 0x00da, 0x00dd,
+    0x00e0, 0x00e3, 0x00e6, 0x00e9, 0x00ec, 0x00ef, 0x00f2, 0x00f5,
+    0x00f8, 0x00fb, 0x00fe, 0x0101, 0x0104, 0x0105, 0x0108, 0x010b,
+};
+
+const bitmap_font_t bitmap_font_tiny5 = {
+    .data = bitmap_data,
+    .offsets = bitmap_offsets,
+    .height = 5,
+    .bytes_per_column = 1,
+};
+
+/* font data: 459 bytes */
@@ -23,6 +23,22 @@
 
 #include "include/bitmap_fonts.h"
 
+static unsigned subset_index(const uint8_t *subset, unsigned idx)
+{
+    if (!(subset[idx >> 3] & (1U << (idx & 0x7)))) {
+        idx = (uint8_t)'?' - 0x20;
+        /* the '?' glyph is always part of a subset */
+        assert(subset[idx >> 3] & (1U << (idx & 0x7)));
+    }
+
+    unsigned result = __builtin_popcount(subset[idx >> 3] & ((1U << (idx & 0x7)) - 1));
+    for (unsigned i = 0; i < (idx >> 3); i++) {
+        result += __builtin_popcount(subset[i]);
+    }
+
+    return result;
+}
+
 bitmap_glyph_t bitmap_font_get(const bitmap_font_t *font, char codepoint)
 {
     assert(font != NULL);
@@ -33,12 +49,22 @@ bitmap_glyph_t bitmap_font_get(const bitmap_font_t *font, char codepoint)
         idx = (uint8_t)'?' - 0x020;
     }
 
-    /* Dark Magic: The access `font->offsets[idx + 1]` may overflow by one
-     * element and access the struct member `data_size` instead; which contains
-     * exactly the value we are after in the case it overflows :) */
+    if (font->subset) {
+        idx = subset_index(font->subset, idx);
+    }
+
+#if MODULE_BITMAP_FONTS_DICT
+    if (font->dict) {
+        return bitmap_font_dict_get(font, idx);
+    }
+#endif
+
+    assert(font->offsets != NULL);
     bitmap_glyph_t result = {
-        .data = font->data + font->offsets[idx],
+        .data = font->data + font->offsets[idx] * font->bytes_per_column,
         .width = font->offsets[idx + 1] - font->offsets[idx],
+        .height = font->height,
+        .bytes_per_column = font->bytes_per_column,
     };
 
     return result;
@@ -67,25 +93,10 @@ bool bitmap_glyph_space_between(const bitmap_glyph_t *left, const bitmap_glyph_t
 {
     assert((left != NULL) && (right != NULL));
 
-    uint16_t x1 = left->width - 1;
-    const uint16_t x2 = 0;
-    if ((left->data[x1] & 1U) && (right->data[x2] & 1U)) {
-        return true;
-    }
-
-    for (unsigned y = 1; y < 8; y++) {
-        if ((left->data[x1] & (1U << y)) && (right->data[x2] & (1U << y))) {
-            return true;
-        }
-
-        if ((left->data[x1] & (1U << (y - 1))) && (right->data[x2] & (1U << y))) {
-            return true;
-        }
-
-        if ((left->data[x1] & (1U << y)) && (right->data[x2] & (1U << (y - 1)))) {
-            return true;
-        }
-    }
+    /* A space is needed if a pixel in the last column of left touches a pixel
+     * in the first column of right, either horizontally or diagonally */
+    uint32_t l = bitmap_glyph_column(left, left->width - 1);
+    uint32_t r = bitmap_glyph_column(right, 0);
 
-    return false;
+    return l & (r | (r << 1) | (r >> 1));
 }
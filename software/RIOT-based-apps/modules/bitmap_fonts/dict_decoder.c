@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bitmap_fonts
+ * @{
+ *
+ * @file
+ * @brief       Decoder and glyph cache for fonts using the column dictionary
+ *              encoding
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include "include/bitmap_fonts.h"
+
+#define DICT_CODE_BITS      5U
+#define DICT_CODE_MASK      ((1U << DICT_CODE_BITS) - 1)
+#define DICT_ESCAPE         DICT_CODE_MASK
+#define DICT_ANCHOR_SHIFT   3U
+
+static_assert(CONFIG_BITMAP_FONTS_CACHE_SIZE >= 2,
+              "Rendering text needs at least two glyphs to be cached at a time");
+
+struct cache_entry {
+    const bitmap_font_t *font;
+    uint32_t last_used;
+    uint8_t idx;
+    uint8_t width;
+    uint8_t data[CONFIG_BITMAP_FONTS_DICT_WIDTH_MAX];
+};
+
+static struct cache_entry cache[CONFIG_BITMAP_FONTS_CACHE_SIZE];
+static uint32_t cache_clock;
+
+static unsigned read_bits(const uint8_t *data, unsigned pos)
+{
+    /* the code stream is padded by one byte, so reading two bytes is safe */
+    unsigned word = data[pos >> 3] | ((unsigned)data[(pos >> 3) + 1] << 8);
+    return word >> (pos & 0x7);
+}
+
+static unsigned glyph_width(const bitmap_font_dict_t *dict, unsigned idx)
+{
+    return (dict->widths[idx >> 1] >> ((idx & 0x1) << 2)) & 0xf;
+}
+
+static unsigned skip_glyph(const uint8_t *data, unsigned pos, unsigned numof)
+{
+    while (numof--) {
+        if ((read_bits(data, pos) & DICT_CODE_MASK) == DICT_ESCAPE) {
+            pos += 8;
+        }
+        pos += DICT_CODE_BITS;
+    }
+
+    return pos;
+}
+
+static void decode(struct cache_entry *entry)
+{
+    const bitmap_font_dict_t *dict = entry->font->dict;
+    const uint8_t *data = entry->font->data;
+    unsigned bytes_per_column = entry->font->bytes_per_column;
+    unsigned pos = dict->anchors[entry->idx >> DICT_ANCHOR_SHIFT];
+
+    for (unsigned i = entry->idx & ~((1U << DICT_ANCHOR_SHIFT) - 1); i < entry->idx; i++) {
+        pos = skip_glyph(data, pos, glyph_width(dict, i) * bytes_per_column);
+    }
+
+    entry->width = glyph_width(dict, entry->idx);
+    unsigned numof = entry->width * bytes_per_column;
+    assert(numof <= CONFIG_BITMAP_FONTS_DICT_WIDTH_MAX);
+
+    for (unsigned x = 0; x < numof; x++) {
+        unsigned code = read_bits(data, pos) & DICT_CODE_MASK;
+        pos += DICT_CODE_BITS;
+        if (code == DICT_ESCAPE) {
+            entry->data[x] = read_bits(data, pos);
+            pos += 8;
+        }
+        else {
+            entry->data[x] = dict->columns[code];
+        }
+    }
+}
+
+bitmap_glyph_t bitmap_font_dict_get(const bitmap_font_t *font, unsigned idx)
+{
+    assert((font != NULL) && (font->dict != NULL));
+
+    struct cache_entry *entry = &cache[0];
+    for (unsigned i = 0; i < CONFIG_BITMAP_FONTS_CACHE_SIZE; i++) {
+        if ((cache[i].font == font) && (cache[i].idx == idx)) {
+            entry = &cache[i];
+            goto hit;
+        }
+        if (cache[i].last_used < entry->last_used) {
+            entry = &cache[i];
+        }
+    }
+
+    /* miss: entry is the least recently used one */
+    entry->font = font;
+    entry->idx = idx;
+    decode(entry);
+
+hit:
+    entry->last_used = ++cache_clock;
+
+    bitmap_glyph_t result = {
+        .data = entry->data,
+        .width = entry->width,
+        .height = font->height,
+        .bytes_per_column = font->bytes_per_column,
+    };
+
+    return result;
+}
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""
+Convert strings and icons into pre-rendered bitmaps in the same column-wise
+layout as glyphs of the bitmap_fonts module.
+
+The assets file lists one asset per line in the form `<name> = <source>`,
+where source is either a string literal (rendered with the given font) or the
+path of a PBM (or PNG, if Pillow is installed) image relative to the assets
+file. Empty lines and lines starting with `#` are ignored.
+"""
+
+from argparse import ArgumentParser
+from ast import literal_eval
+from os.path import basename, dirname, join, splitext
+from sys import exit
+
+from bdfparser import Font
+from bdf2c import glyph_columns, column_bytes, print_array
+
+LICENSE_HEADER = """/*
+ * Copyright (C) {copyright}
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+"""
+
+
+def parse_assets(path):
+    assets = []
+    with open(path, encoding="utf-8") as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            name, sep, source = (s.strip() for s in line.partition("="))
+            if not sep or not name.isidentifier():
+                exit(f"{path}:{lineno}: expected `<name> = <source>`")
+            if source[0] in "\"'":
+                assets.append((name, "text", literal_eval(source)))
+            else:
+                assets.append((name, "image", join(dirname(path), source)))
+    return assets
+
+
+def read_pbm(path):
+    """Read a plain (P1) or raw (P4) PBM file into a list of rows of bits"""
+    with open(path, "rb") as f:
+        content = f.read()
+
+    magic = content[:2]
+    tokens = []
+    pos = 2
+    # parse the header (magic, width, height), skipping comments
+    while len(tokens) < 2:
+        while content[pos:pos + 1].isspace():
+            pos += 1
+        if content[pos:pos + 1] == b"#":
+            pos = content.index(b"\n", pos)
+            continue
+        start = pos
+        while not content[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(int(content[start:pos]))
+    width, height = tokens
+    pos += 1
+
+    if magic == b"P1":
+        bits = [int(c) for c in content[pos:].decode("ascii") if c in "01"]
+        return [bits[y * width:(y + 1) * width] for y in range(height)]
+
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            row = content[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([(row[x >> 3] >> (7 - (x & 0x7))) & 1 for x in range(width)])
+        return rows
+
+    exit(f"{path}: only P1 and P4 PBM files are supported")
+
+
+def read_image(path):
+    if path.endswith(".pbm"):
+        return read_pbm(path)
+
+    try:
+        from PIL import Image
+    except ImportError:
+        exit(f"{path}: Pillow is needed to read images other than PBM")
+
+    img = Image.open(path).convert("L")
+    # dark pixels are set, as in PBM
+    return [[int(img.getpixel((x, y)) < 128) for x in range(img.width)]
+            for y in range(img.height)]
+
+
+def image_columns(rows):
+    columns = []
+    for x in range(len(rows[0])):
+        val = 0
+        for y, row in enumerate(rows):
+            if row[x]:
+                val |= 1 << y
+        columns.append(val)
+    return columns
+
+
+def space_between(left, right):
+    """Same as bitmap_glyph_space_between() in C"""
+    return (left & (right | (right << 1) | (right >> 1))) != 0
+
+
+def render_text(font, text, space_width):
+    columns = []
+    for char in text:
+        cp = ord(char)
+        if (cp < 0x20) or (cp > 0x7e):
+            cp = ord("?")
+        glyph = glyph_columns(font, cp, space_width)
+        if columns and space_between(columns[-1], glyph[0]):
+            columns.append(0)
+        columns += glyph
+    return columns
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description="Convert strings and icons to C code")
+    parser.add_argument("assets_file", metavar="ASSETS_FILE")
+    parser.add_argument("--font", help="BDF file of the font to render strings with")
+    parser.add_argument("--space-width", type=int, default=3,
+                        help="width of the space glyph in columns")
+    parser.add_argument("--header", metavar="HEADER_NAME",
+                        help="generate the header of the given name declaring the "
+                             "assets instead")
+    parser.add_argument("--copyright", metavar="YEAR_AND_HOLDER",
+                        help="emit the LGPL license header of RIOT with the given "
+                             "copyright, e.g. \"2024 Jane Doe\"")
+    args = parser.parse_args()
+
+    assets = parse_assets(args.assets_file)
+    font = Font(args.font) if args.font else None
+
+    if args.header:
+        guard = splitext(basename(args.header))[0].upper() + "_H"
+        print(f"/* This file is auto generated using {basename(parser.prog)} */")
+        if args.copyright:
+            print(LICENSE_HEADER.format(copyright=args.copyright), end="")
+        print(f"#ifndef {guard}")
+        print(f"#define {guard}\n")
+        print("#include \"bitmap_fonts.h\"\n")
+        print("#ifdef __cplusplus\nextern \"C\" {\n#endif\n")
+        for name, kind, source in assets:
+            what = repr(source) if kind == "text" else basename(source)
+            print(f"extern const bitmap_glyph_t {name}; /**< Pre-rendered {what} */")
+        print("\n#ifdef __cplusplus\n}\n#endif\n")
+        print(f"#endif /* {guard} */")
+        exit(0)
+
+    print(f"/* This file is auto generated using {basename(parser.prog)} */")
+    if args.copyright:
+        print(LICENSE_HEADER.format(copyright=args.copyright), end="")
+    print("#include <stdint.h>")
+    print("#include \"bitmap_fonts.h\"")
+    print("")
+
+    total = 0
+    for name, kind, source in assets:
+        if kind == "text":
+            if font is None:
+                exit("--font is needed to render strings")
+            height = font.headers["fbby"]
+            columns = render_text(font, source, args.space_width)
+        else:
+            rows = read_image(source)
+            height = len(rows)
+            columns = image_columns(rows)
+
+        if height > 16:
+            exit(f"{name}: assets higher than 16 pixels are not supported")
+        bytes_per_column = (height + 7) // 8
+        data = column_bytes(columns, bytes_per_column)
+        total += len(data)
+
+        print_array("uint8_t", f"_{name}", data, "#04x")
+        print(f"const bitmap_glyph_t {name} = " + "{")
+        print(f"    .data = _{name},")
+        print(f"    .width = {len(columns)},")
+        print(f"    .height = {height},")
+        print(f"    .bytes_per_column = {bytes_per_column},")
+        print("};\n")
+
+    print(f"/* asset data: {total} bytes */")
@@ -1,63 +1,215 @@
 #!/usr/bin/env python3
 # SPDX-License-Identifier: MIT
 
+from argparse import ArgumentParser
 from bdfparser import Font
-from sys import argv, exit
+from collections import Counter
 from os.path import splitext, basename
+from sys import exit
+import re
 
+# number of entries in the column dictionary; the code after the last entry
+# is the escape code that is followed by a raw 8 bit column
+DICT_ENTRIES = 31
+DICT_CODE_BITS = 5
+DICT_ESCAPE = DICT_ENTRIES
+# a bit offset into the code stream is stored for every n-th glyph
+DICT_ANCHOR_EVERY = 8
 
-if __name__ == '__main__':
-    if len(argv) != 2:
-        exit(f"Usage: {argv[0]} <BPF_FILE>")
-
-    font = Font(argv[1])
 
+def glyph_columns(font, codepoint, space_width):
+    """Return the columns of the glyph as list of ints, LSB is topmost"""
     # trimming off empty space from the space glyph won't work, so we add that
     # by hand
-    fontdata = [0x00, 0x00, 0x00]
-    offsets = [0]
-    offset = len(fontdata)
-    for codepoint in range(0x21, 0x7e):
-        bitmap = font.glyph(chr(codepoint)).draw().todata()
-        data = []
-        for idx in range(len(bitmap[0])):
-            val = 0
-            for line in range(8):
-                if bitmap[line][idx] == '1':
-                    val |= (1 << line)
-            data.append(val)
-
-        # trim empty space left and right
-        while data[0] == 0:
-            data = data[1:]
-        while data[-1] == 0:
-            data = data[:-1]
-
-        # append bitmap data
-        fontdata += data
-        offsets.append(offset)
-        offset += len(data)
-
-    print(f"/* This file is auto generated using {basename(argv[0])} */")
+    if codepoint == 0x20:
+        return [0x00] * space_width
+
+    bitmap = font.glyph(chr(codepoint)).draw().todata()
+    data = []
+    for idx in range(len(bitmap[0])):
+        val = 0
+        for line in range(len(bitmap)):
+            if bitmap[line][idx] == '1':
+                val |= (1 << line)
+        data.append(val)
+
+    # trim empty space left and right
+    while data[0] == 0:
+        data = data[1:]
+    while data[-1] == 0:
+        data = data[:-1]
+
+    return data
+
+
+def column_bytes(data, bytes_per_column):
+    """Split the columns into bytes, least significant byte first"""
+    return [(col >> (8 * i)) & 0xff for col in data for i in range(bytes_per_column)]
+
+
+C_TOKENS = re.compile(r"""#\s*include[^\n]*|//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\\n])*"|'(?:\\.|[^'\\\n])*'""", re.S)
+
+
+def literal_chars(path):
+    """Return the set of characters used in string and character literals"""
+    with open(path, encoding="utf-8", errors="replace") as f:
+        source = f.read()
+
+    result = set()
+    for token in C_TOKENS.findall(source):
+        if token[0] not in "\"'":
+            # a comment or an include directive
+            continue
+        text = token[1:-1].encode("latin-1", "backslashreplace")
+        result |= set(text.decode("unicode_escape"))
+
+    return result
+
+
+def print_array(ctype, name, values, fmt, per_line=8):
+    print(f"static const {ctype} {name}[] = {{")
+    for i in range(0, len(values), per_line):
+        line = " ".join(f"{v:{fmt}}," for v in values[i:i + per_line])
+        print(f"    {line}")
+    print("};\n")
+
+
+def print_header(prog):
+    print(f"/* This file is auto generated using {basename(prog)} */")
     print("#include <stdint.h>")
     print("#include \"bitmap_fonts.h\"")
     print("")
 
-    print("static const uint8_t bitmap_data[] = {")
-    print(f"    {fontdata[0]:#04x},", end='')
-    for i in range(1, len(fontdata)):
-        print(f" {fontdata[i]:#04x},", end='')
-        if ((i + 1) % 8) == 0:
-            print("\n   ", end='')
-    print("\n};\n")
 
-    print(f"const bitmap_font_t {splitext(argv[1])[0]} = " + "{")
-    print(f"    .data_size = {len(fontdata):#06x},")
+def print_font(name, height, bytes_per_column, members, subset):
+    if subset is not None:
+        print_array("uint8_t", "bitmap_subset", subset, "#04x")
+        members = members + [".subset = bitmap_subset"]
+    print(f"const bitmap_font_t {name} = " + "{")
     print("    .data = bitmap_data,")
-    print("    .offsets = {")
-    print(f"        {offsets[0]:#06x},", end='')
-    for i in range(1, len(offsets)):
-        print(f" {offsets[i]:#06x},", end='')
-        if ((i + 1) % 8) == 0:
-            print("\n       ", end='')
-    print("\n    },\n};")
+    for member in members:
+        print(f"    {member},")
+    print(f"    .height = {height},")
+    print(f"    .bytes_per_column = {bytes_per_column},")
+    print("};")
+
+
+def emit_raw(prog, name, glyphs, height, bytes_per_column, subset):
+    fontdata = []
+    offsets = []
+    columns = 0
+    for data in glyphs:
+        offsets.append(columns)
+        fontdata += column_bytes(data, bytes_per_column)
+        columns += len(data)
+    offsets.append(columns)
+
+    print_header(prog)
+    print_array("uint8_t", "bitmap_data", fontdata, "#04x")
+    print_array("uint16_t", "bitmap_offsets", offsets, "#06x")
+    print_font(name, height, bytes_per_column, [".offsets = bitmap_offsets"], subset)
+
+    return len(fontdata) + 2 * len(offsets) + len(subset or [])
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = 0
+        self.len = 0
+
+    def write(self, value, width):
+        self.bits |= value << self.len
+        self.len += width
+
+    def tobytes(self):
+        # one byte of padding, so that the decoder can always fetch 16 bits
+        numof = (self.len + 7) // 8 + 1
+        return list(self.bits.to_bytes(numof, "little"))
+
+
+def emit_dict(prog, name, glyphs, height, bytes_per_column, subset):
+    counts = Counter(column_bytes([col for data in glyphs for col in data], bytes_per_column))
+    dictionary = [col for col, _ in counts.most_common(DICT_ENTRIES)]
+    codes = {col: code for code, col in enumerate(dictionary)}
+
+    stream = BitWriter()
+    anchors = []
+    widths = []
+    for idx, data in enumerate(glyphs):
+        assert len(data) < 16, "glyph too wide for nibble encoded widths"
+        if (idx % DICT_ANCHOR_EVERY) == 0:
+            anchors.append(stream.len)
+        widths.append(len(data))
+        for col in column_bytes(data, bytes_per_column):
+            if col in codes:
+                stream.write(codes[col], DICT_CODE_BITS)
+            else:
+                stream.write(DICT_ESCAPE, DICT_CODE_BITS)
+                stream.write(col, 8)
+
+    assert stream.len <= 0xffff, "code stream too long for 16 bit anchors"
+
+    if len(widths) % 2:
+        widths.append(0)
+    packed_widths = [widths[i] | (widths[i + 1] << 4) for i in range(0, len(widths), 2)]
+    data = stream.tobytes()
+
+    print_header(prog)
+    print_array("uint8_t", "bitmap_data", data, "#04x")
+    print_array("uint8_t", "bitmap_columns", dictionary, "#04x")
+    print_array("uint8_t", "bitmap_widths", packed_widths, "#04x")
+    print_array("uint16_t", "bitmap_anchors", anchors, "#06x")
+    print("static const bitmap_font_dict_t bitmap_dict = {")
+    print("    .columns = bitmap_columns,")
+    print("    .widths = bitmap_widths,")
+    print("    .anchors = bitmap_anchors,")
+    print("};\n")
+    print_font(name, height, bytes_per_column, [".dict = &bitmap_dict"], subset)
+
+    return len(data) + len(dictionary) + len(packed_widths) + 2 * len(anchors) \
+        + len(subset or [])
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description="Convert a BDF font to C code")
+    parser.add_argument("bdf_file", metavar="BDF_FILE")
+    parser.add_argument("--encoding", choices=["raw", "dict"], default="raw",
+                        help="raw: one byte per column (fastest), "
+                             "dict: shared column dictionary (smallest)")
+    parser.add_argument("--name", help="name of the C variable holding the font")
+    parser.add_argument("--space-width", type=int, default=3,
+                        help="width of the space glyph in columns")
+    parser.add_argument("--subset-chars", default=None,
+                        help="only include the given characters (plus '?') in the font")
+    parser.add_argument("--subset-sources", nargs="+", default=[], metavar="C_FILE",
+                        help="only include characters used in string and character "
+                             "literals of the given C files (plus --subset-chars)")
+    args = parser.parse_args()
+
+    font = Font(args.bdf_file)
+    name = args.name or splitext(basename(args.bdf_file))[0]
+    height = font.headers["fbby"]
+    if height > 16:
+        exit("Fonts higher than 16 pixels are not supported")
+    bytes_per_column = (height + 7) // 8
+    codepoints = range(0x20, 0x7f)
+    subset = None
+
+    if (args.subset_chars is not None) or args.subset_sources:
+        # the '?' glyph is used as replacement for missing glyphs
+        chars = set(args.subset_chars or "") | {"?"}
+        for path in args.subset_sources:
+            chars |= literal_chars(path)
+        codepoints = [cp for cp in codepoints if chr(cp) in chars]
+        subset = [0] * ((0x7f - 0x20 + 7) // 8)
+        for cp in codepoints:
+            subset[(cp - 0x20) >> 3] |= 1 << ((cp - 0x20) & 0x7)
+
+    glyphs = [glyph_columns(font, cp, args.space_width) for cp in codepoints]
+
+    if args.encoding == "dict":
+        size = emit_dict(parser.prog, name, glyphs, height, bytes_per_column, subset)
+    else:
+        size = emit_raw(parser.prog, name, glyphs, height, bytes_per_column, subset)
+
+    print(f"\n/* font data: {size} bytes */")
@@ -31,29 +31,98 @@ extern "C" {
 #endif
 
 /**
- * @brief   Data structure holding a bitmap font of 8 pixel height and variable
- *          width
+ * @brief   Number of decoded glyphs of compressed fonts to keep in RAM
+ *
+ * A glyph returned by @ref bitmap_font_get for a compressed font points into
+ * this cache and remains valid for at least `CONFIG_BITMAP_FONTS_CACHE_SIZE - 1`
+ * further calls of @ref bitmap_font_get.
+ */
+#ifndef CONFIG_BITMAP_FONTS_CACHE_SIZE
+#  define CONFIG_BITMAP_FONTS_CACHE_SIZE        4
+#endif
+
+/**
+ * @brief   Maximum size of a glyph in a compressed font in bytes
+ *
+ * Each entry in the glyph cache reserves this number of bytes. This is the
+ * maximum glyph width times @ref bitmap_font_t::bytes_per_column.
+ */
+#ifndef CONFIG_BITMAP_FONTS_DICT_WIDTH_MAX
+#  define CONFIG_BITMAP_FONTS_DICT_WIDTH_MAX    8
+#endif
+
+/**
+ * @brief   Index data of a font using the column dictionary encoding
+ *
+ * The glyph bitmaps are stored as a bit stream (LSB first) of 5 bit codes,
+ * one code per column byte. Codes 0 to 30 refer to an entry in @ref
+ * bitmap_font_dict_t::columns, code 31 is an escape code followed by the 8
+ * bit column value. The width of each glyph is stored as nibble, and the bit
+ * offset of every 8th glyph in the stream is stored in @ref
+ * bitmap_font_dict_t::anchors.
+ *
+ * Use `dist/bdf2c.py --encoding dict` to generate fonts in this format.
+ * Module `bitmap_fonts_dict` is needed to decode them.
  */
 typedef struct {
-    const uint8_t *data;    /**< Bitmap data column-wise */
-    uint16_t offsets[94];   /**< Offset of the glyphs in data */
+    const uint8_t *columns;     /**< The 31 most frequent column bytes */
+    const uint8_t *widths;      /**< Glyph widths, two glyphs per byte (low nibble first) */
+    const uint16_t *anchors;    /**< Bit offset of every 8th glyph in the code stream */
+} bitmap_font_dict_t;
+
+/**
+ * @brief   Maximum height of a bitmap font in pixels
+ */
+#define BITMAP_FONTS_HEIGHT_MAX             16
+
+/**
+ * @brief   Data structure holding a bitmap font of up to 16 pixel height and
+ *          variable width
+ *
+ * Each column of a glyph is stored in @ref bitmap_font_t::bytes_per_column
+ * bytes, with the least significant byte first and the least significant bit
+ * being the topmost pixel.
+ */
+typedef struct {
+    /**
+     * @brief   Bitmap data column-wise or the code stream for compressed fonts
+     */
+    const uint8_t *data;
+    /**
+     * @brief   Offset of the glyphs in data (in columns)
+     *
+     * This has one entry more than there are glyphs, so that for every glyph
+     * index `i` the expression `.offsets[i + 1] - .offsets[i]` yields the
+     * glyph width. This is `NULL` for compressed fonts.
+     */
+    const uint16_t *offsets;
+    /**
+     * @brief   Index data of compressed fonts, or `NULL` for raw fonts
+     */
+    const bitmap_font_dict_t *dict;
     /**
-     * @brief   Length of the data array
+     * @brief   Bitmap of the glyphs present in a subset font, or `NULL` if
+     *          all glyphs are present
      *
-     * This intentionally is laid out in memory that an access of offsets out
-     * of bounds by 1 will access the data size. For every glyph index
-     * `i`, this way `.offsets[i + 1] - .offsets[i]` will yield the glyph
-     * width.
+     * Bit `i` (LSB first) is set if the glyph of codepoint `0x20 + i` is
+     * present. Glyphs are stored in the order of their codepoints, so the
+     * number of bits set below bit `i` is the index of the glyph in @ref
+     * bitmap_font_t::offsets or the code stream. Missing glyphs are rendered
+     * as `?`.
      */
-    uint16_t data_size;
+    const uint8_t *subset;
+    uint8_t height;             /**< Height of the font in pixels */
+    uint8_t bytes_per_column;   /**< Number of bytes used to store a column */
 } bitmap_font_t;
 
 /**
  * @brief   Data structure holding a bitmap font glyph
  */
 typedef struct {
-    const uint8_t *data;    /**< Bitmap data column-wise */
-    uint8_t width;          /**< Width of the glyph in columns */
+    const uint8_t *data;        /**< Bitmap data column-wise */
+    uint16_t width;             /**< Width of the glyph in columns */
+    uint8_t height;             /**< Height of the glyph in pixels */
+    uint8_t bytes_per_column;   /**< Number of bytes used to store a column */
 } bitmap_glyph_t;
 
 /**
@@ -72,9 +141,30 @@ extern const bitmap_glyph_t bitmap_glyph_thumb_down;    /**< A thump down emoji
 
 /**
  * @brief   The MatrixLight8 bitmap font from https://github.com/trip5/Matrix-Fonts
+ *
+ * @note    With module `bitmap_fonts_subset` only the glyphs used by the
+ *          app are included, see `BITMAP_FONTS_SUBSET_CHARS`
  */
 extern const bitmap_font_t bitmap_font_matrix_light8;
 
+/**
+ * @brief   The MatrixLight8 bitmap font using the column dictionary encoding
+ *
+ * This needs about 30 % less flash than @ref bitmap_font_matrix_light8, but
+ * decoding a glyph not in the glyph cache is slower.
+ *
+ * @note    Only available with module `bitmap_fonts_dict`
+ */
+extern const bitmap_font_t bitmap_font_matrix_light8_dict;
+
+/**
+ * @brief   A tiny 3x5 pixel font with upper case letters only
+ *
+ * Lower case letters are rendered as upper case letters. This allows
+ * two-line layouts or showing a score next to an icon.
+ */
+extern const bitmap_font_t bitmap_font_tiny5;
+
 /**
  * @brief   Check if the pixel at the give x,y coordinates is set in the given glyph.
  *
@@ -85,11 +175,30 @@ extern const bitmap_font_t bitmap_font_matrix_light8;
  * @retval  true        The pixel at the give coordinates in @p glyph is set.
  * @retval  false       The pixel is *NOT* set.
  */
-static inline bool bitmap_glyph_at(const bitmap_glyph_t *glyph, uint8_t x, uint8_t y)
+static inline bool bitmap_glyph_at(const bitmap_glyph_t *glyph, uint16_t x, uint8_t y)
 {
-    assert((glyph != NULL) && (y < 8) && (x < glyph->width));
+    assert((glyph != NULL) && (y < glyph->height) && (x < glyph->width));
 
-    return (glyph->data[x] & (1U << y));
+    return (glyph->data[x * glyph->bytes_per_column + (y >> 3)] & (1U << (y & 0x7)));
+}
+
+/**
+ * @brief   Get the given column of the glyph as bitmask
+ *
+ * @param[in]   glyph   Glyph to get the column from
+ * @param[in]   x       X coordinate (0 is leftmost)
+ *
+ * @return  The column with the least significant bit being the topmost pixel
+ */
+static inline uint16_t bitmap_glyph_column(const bitmap_glyph_t *glyph, uint16_t x)
+{
+    assert((glyph != NULL) && (x < glyph->width));
+
+    if (glyph->bytes_per_column == 1) {
+        return glyph->data[x];
+    }
+
+    return glyph->data[2 * x] | ((uint16_t)glyph->data[2 * x + 1] << 8);
 }
 
 /**
@@ -100,9 +209,26 @@ static inline bool bitmap_glyph_at(const bitmap_glyph_t *glyph, uint8_t x, uint8
  *
  * @return  The requested glyph
  * @retval  `?`             if `(codepoints < 0x20) || (codepoint > 0x7e)`
+ *
+ * @warning For compressed fonts the returned glyph points into the glyph
+ *          cache, which is shared between all threads and will be reused
+ *          after `CONFIG_BITMAP_FONTS_CACHE_SIZE - 1` more calls.
  */
 bitmap_glyph_t bitmap_font_get(const bitmap_font_t *font, char codepoint);
 
+/**
+ * @brief   Get the glyph at the given index of a compressed font
+ *
+ * @param[in]   font        The compressed bitmap font to get the glyph from
+ * @param[in]   idx         Index of the glyph (codepoint - 0x20)
+ *
+ * @return  The requested glyph, with data pointing into the glyph cache
+ *
+ * @note    This is used internally by @ref bitmap_font_get and provided by
+ *          module `bitmap_fonts_dict`
+ */
+bitmap_glyph_t bitmap_font_dict_get(const bitmap_font_t *font, unsigned idx);
+
 /**
  * @brief   Get the width (in pixels) of the given text rendered in the given
  *          font.
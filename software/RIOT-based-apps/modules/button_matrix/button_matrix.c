@@ -1,15 +1,208 @@
+#include <assert.h>
 #include <string.h>
 
 #include "button_matrix.h"
+#include "button_matrix_events.h"
 #include "button_matrix_params.h"
+
+#if MODULE_BUTTON_MATRIX_SCRIPT
+#include "architecture.h"
+#else
 #include "periph/gpio_ll.h"
+#endif
+
+#if MODULE_BUTTON_MATRIX_SCRIPT || MODULE_BUTTON_MATRIX_RECORD
+#include "button_matrix_script.h"
+#endif
+
+#if MODULE_FLASH_KV && !MODULE_BUTTON_MATRIX_SCRIPT
+#include "flash_kv.h"
+#endif
+
+/* maps every possible scan result to the buttons actually pressed, per
+ * number of pins. Generated by dist/ghost_lut.py, so they live in flash */
+#include "ghost_lut.h"
+
+#define BTN_BYTES           ((BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8)
+#define USE_GHOST_LUT       ((BUTTON_MATRIX_PIN_NUMOF <= GHOST_LUT_PINS_MAX) && \
+                             (BUTTON_MATRIX_BUTTON_NUMOF <= \
+                              CONFIG_BUTTON_MATRIX_GHOST_LUT_BUTTONS_MAX))
+
+static_assert(BUTTON_MATRIX_PIN_NUMOF <= 16, "at most 16 pins are supported");
 
 static uword_t button_io_masks[BUTTON_MATRIX_PIN_NUMOF];
+#if !MODULE_BUTTON_MATRIX_SCRIPT
 static uword_t button_dir_masks[BUTTON_MATRIX_PIN_NUMOF];
 static uword_t button_io_mask_all;
 static uword_t button_dir_mask_all;
+#endif
 
-int button_matrix_init(void)
+#if MODULE_BUTTON_MATRIX_SCRIPT
+static uint8_t driven_column;
+
+static void scan_to_pins(uint16_t *reach, const uint8_t *scan);
+
+/* Emulate the input register: the driven pin plus all pins connected to it
+ * by a button pressed according to the script */
+static uword_t read_pins(void)
+{
+    uint8_t scan[BTN_BYTES] = { button_matrix_script_scan() };
+    uint16_t reach[BUTTON_MATRIX_PIN_NUMOF];
+    scan_to_pins(reach, scan);
+
+    uword_t result = button_io_masks[driven_column];
+    for (unsigned x = 0; x < BUTTON_MATRIX_PIN_NUMOF; x++) {
+        if (reach[driven_column] & (1U << x)) {
+            result |= button_io_masks[x];
+        }
+    }
+
+    return result;
+}
+#else
+static uword_t read_pins(void)
+{
+    return gpio_ll_read(BUTTON_MATRIX_PORT);
+}
+#endif
+
+#if MODULE_BUTTON_MATRIX_SCRIPT
+/* the emulated inputs settle right away, there is nothing to calibrate */
+static uword_t read_settled(unsigned y)
+{
+    (void)y;
+    return read_pins();
+}
+#else
+/* number of dummy reads needed for the inputs to register a change */
+static uint8_t settle_reads = CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX;
+static bool calibrated;
+#if MODULE_FLASH_KV
+static bool calibration_unsaved;
+#endif
+
+/* Measure how many reads it takes for driven pin y to show up at pin x via
+ * a pressed button, i.e. on the actual input path. Called with the first
+ * button seen pressed, as nothing can be measured without one */
+static void calibrate(unsigned y, uword_t col)
+{
+    unsigned x;
+
+    col &= ~button_io_masks[y];
+    for (x = 0; x < BUTTON_MATRIX_PIN_NUMOF; x++) {
+        if (col & button_io_masks[x]) {
+            break;
+        }
+    }
+    if (x == BUTTON_MATRIX_PIN_NUMOF) {
+        return;
+    }
+
+    /* driving the column discharges the path first */
+    button_matrix_drive_column(y);
+    unsigned reads = 1;
+    while (!(read_pins() & button_io_masks[x])) {
+        if (++reads > CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX) {
+            /* released meanwhile, try again with the next press */
+            return;
+        }
+    }
+
+    reads = (reads * (100 + CONFIG_BUTTON_MATRIX_SETTLE_MARGIN_PERCENT) + 99) / 100;
+    if (reads > CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX) {
+        reads = CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX;
+    }
+    settle_reads = reads;
+    calibrated = true;
+#if MODULE_FLASH_KV
+    calibration_unsaved = true;
+#endif
+}
+
+/* read the driven column after the inputs settled */
+static uword_t read_settled(unsigned y)
+{
+    for (unsigned i = 0; i < settle_reads; i++) {
+        (void)read_pins();
+    }
+
+    uword_t col = read_pins();
+    if (!calibrated) {
+        calibrate(y, col);
+    }
+    return col;
+}
+
+/* Keep the result across reboots. Called with the matrix released, as
+ * writing the flash may take a while */
+static void calibration_store(void)
+{
+#if MODULE_FLASH_KV
+    if (calibration_unsaved) {
+        calibration_unsaved = false;
+        flash_kv_set_u32(FLASH_KV_KEY_BUTTON_MATRIX_SETTLE_READS, settle_reads);
+    }
+#endif
+}
+
+static void calibration_load(void)
+{
+#if MODULE_FLASH_KV
+    uint32_t reads = flash_kv_get_u32(FLASH_KV_KEY_BUTTON_MATRIX_SETTLE_READS, 0);
+    if ((reads > 0) && (reads <= CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX)) {
+        settle_reads = reads;
+        calibrated = true;
+    }
+#endif
+}
+#endif
+
+/* Position of the button connecting driven pin y with read pin x in the
+ * output of button_matrix_scan() */
+static unsigned btn_pos(unsigned y, unsigned x)
+{
+    unsigned pos = y * (BUTTON_MATRIX_WIDTH - 1) + (BUTTON_MATRIX_WIDTH - 1 - x);
+    return (x < y) ? pos - 1 : pos;
+}
+
+/* Convert a scan into a bitmask of pins reachable for each driven pin */
+static void scan_to_pins(uint16_t *reach, const uint8_t *scan)
+{
+    for (unsigned y = 0; y < BUTTON_MATRIX_HEIGHT; y++) {
+        reach[y] = 0;
+        for (unsigned x = 0; x < BUTTON_MATRIX_WIDTH; x++) {
+            unsigned pos = btn_pos(y, x);
+            if ((x != y) && (scan[pos >> 3] & (1U << (pos & 0x7)))) {
+                reach[y] |= 1U << x;
+            }
+        }
+    }
+}
+
+static void pins_to_scan(uint8_t *scan, const uint16_t *reach)
+{
+    memset(scan, 0, BTN_BYTES);
+    for (unsigned y = 0; y < BUTTON_MATRIX_HEIGHT; y++) {
+        for (unsigned x = 0; x < BUTTON_MATRIX_WIDTH; x++) {
+            unsigned pos = btn_pos(y, x);
+            if ((x != y) && (reach[y] & (1U << x))) {
+                scan[pos >> 3] |= 1U << (pos & 0x7);
+            }
+        }
+    }
+}
+
+#if MODULE_BUTTON_MATRIX_SCRIPT
+static int init_pins(void)
+{
+    for (unsigned i = 0; i < BUTTON_MATRIX_PIN_NUMOF; i++) {
+        button_io_masks[i] = 1U << button_matrix_pins[i];
+    }
+
+    return 0;
+}
+#else
+static int init_pins(void)
 {
     int retval;
 
@@ -33,68 +226,160 @@ int button_matrix_init(void)
 
     return 0;
 }
+#endif
 
-bool button_matrix_test(uint8_t _x, uint8_t y)
+int button_matrix_init(void)
 {
-    uint8_t x = BUTTON_MATRIX_WIDTH - 1 - _x;
-    if ((x == y) || (_x >= BUTTON_MATRIX_WIDTH) || (y >= BUTTON_MATRIX_HEIGHT)) {
-        return false;
+    int retval = init_pins();
+    if (retval != 0) {
+        return retval;
     }
 
-    /* push everything low fast, pull downs won't be fast enough */
+#if !MODULE_BUTTON_MATRIX_SCRIPT
+    calibration_load();
+#endif
+
+#if MODULE_BUTTON_MATRIX_EVENTS
+    return button_matrix_events_init();
+#else
+    return 0;
+#endif
+}
+
+void button_matrix_test_batch(const button_matrix_coord_t *coords, size_t numof, uint8_t *dest)
+{
+    memset(dest, 0, (numof + 7) / 8);
+
+    /* drive each column at most once and test all requested buttons in it */
+    for (unsigned y = 0; y < BUTTON_MATRIX_HEIGHT; y++) {
+        bool driven = false;
+        uword_t col = 0;
+
+        for (size_t i = 0; i < numof; i++) {
+            uint8_t x = BUTTON_MATRIX_WIDTH - 1 - coords[i].x;
+            if ((coords[i].y != y) || (x == y) || (coords[i].x >= BUTTON_MATRIX_WIDTH)) {
+                continue;
+            }
+
+            if (!driven) {
+                button_matrix_drive_column(y);
+                col = read_settled(y);
+                driven = true;
+            }
+
+            if (col & button_io_masks[x]) {
+                dest[i >> 3] |= 1U << (i & 0x7);
+            }
+        }
+    }
+
+    button_matrix_release();
+#if !MODULE_BUTTON_MATRIX_SCRIPT
+    calibration_store();
+#endif
+}
+
+bool button_matrix_test(uint8_t x, uint8_t y)
+{
+    const button_matrix_coord_t coord = { .x = x, .y = y };
+    uint8_t result;
+    button_matrix_test_batch(&coord, 1, &result);
+    return result;
+}
+
+void button_matrix_drive_column(unsigned y)
+{
+#if MODULE_BUTTON_MATRIX_SCRIPT
+    driven_column = y;
+#else
+    /* drive everything low quickly, pull down resistors may be weak */
     gpio_ll_clear(BUTTON_MATRIX_PORT, button_io_mask_all);
     gpio_ll_switch_dir_output(BUTTON_MATRIX_PORT, button_dir_mask_all);
-    /* go back to input */
-    gpio_ll_switch_dir_input(BUTTON_MATRIX_PORT, button_dir_mask_all);
 
-    gpio_ll_switch_dir_output(BUTTON_MATRIX_PORT, button_dir_masks[y]);
+    /* Switch all but column to input */
+    gpio_ll_switch_dir_input(BUTTON_MATRIX_PORT, button_dir_mask_all ^ button_dir_masks[y]);
+
+    /* now, drive the column high */
     gpio_ll_set(BUTTON_MATRIX_PORT, button_io_masks[y]);
+#endif
+}
+
+static void column_to_scan(uint8_t *dest, unsigned y, uword_t col)
+{
+    size_t pos = y * (BUTTON_MATRIX_WIDTH - 1);
 
-    /* give the input buffer some time to register the change */
-    for (unsigned i = 0; i < 8; i++) {
-        (void)gpio_ll_read(BUTTON_MATRIX_PORT);
+    for (unsigned x = BUTTON_MATRIX_WIDTH - 1; x < BUTTON_MATRIX_WIDTH; x--) {
+        if (x == y) {
+            continue;
+        }
+        if (col & button_io_masks[x]) {
+            dest[pos >> 3] |= (1U << (pos & 0x7));
+        }
+        pos++;
     }
+}
 
-    /* check if the button is pressed */
-    bool result = (gpio_ll_read(BUTTON_MATRIX_PORT) & button_io_masks[x]);
+void button_matrix_read_column(uint8_t *dest, unsigned y)
+{
+    column_to_scan(dest, y, read_pins());
+}
 
+void button_matrix_release(void)
+{
+#if !MODULE_BUTTON_MATRIX_SCRIPT
     gpio_ll_switch_dir_input(BUTTON_MATRIX_PORT, button_dir_mask_all);
-
-    return result;
+#endif
 }
 
 void button_matrix_scan(uint8_t *dest)
 {
     memset(dest, 0, (BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8);
-    size_t pos = 0;
 
     for (unsigned y = 0; y < BUTTON_MATRIX_HEIGHT; y++) {
-        /* drive everything low quickly, pull down resistors may be weak */
-        gpio_ll_clear(BUTTON_MATRIX_PORT, button_io_mask_all);
-        gpio_ll_switch_dir_output(BUTTON_MATRIX_PORT, button_dir_mask_all);
+        button_matrix_drive_column(y);
+        column_to_scan(dest, y, read_settled(y));
+    }
 
-        /* Switch all but column to input */
-        gpio_ll_switch_dir_input(BUTTON_MATRIX_PORT, button_dir_mask_all ^ button_dir_masks[y]);
+    button_matrix_release();
+#if !MODULE_BUTTON_MATRIX_SCRIPT
+    calibration_store();
+#endif
 
-        /* now, drive the column high */
-        gpio_ll_set(BUTTON_MATRIX_PORT, button_io_masks[y]);
+#if MODULE_BUTTON_MATRIX_RECORD
+    button_matrix_record_scan(dest);
+#endif
+}
 
-        /* give the input buffer some time to register the change on the input pins */
-        for (unsigned i = 0; i < 8; i++) {
-            (void)gpio_ll_read(BUTTON_MATRIX_PORT);
-        }
-        uword_t col = gpio_ll_read(BUTTON_MATRIX_PORT);
+void button_matrix_remove_ghosts(uint8_t *scan)
+{
+    if (USE_GHOST_LUT) {
+        /* the index is only out of bounds when not using the table */
+        scan[0] = ghost_luts[USE_GHOST_LUT ? BUTTON_MATRIX_PIN_NUMOF : 0][scan[0]];
+        return;
+    }
 
-        for (unsigned x = BUTTON_MATRIX_WIDTH - 1; x < BUTTON_MATRIX_WIDTH; x--) {
-            if (x == y) {
-                continue;
-            }
-            if (col & button_io_masks[x]) {
-                dest[pos >> 3] |= (1U << (pos & 0x7));
+    /* remove buttons reachable via two pressed buttons */
+    uint16_t reach[BUTTON_MATRIX_PIN_NUMOF];
+    scan_to_pins(reach, scan);
+
+    uint16_t ghosts[BUTTON_MATRIX_PIN_NUMOF] = { 0 };
+    for (unsigned y = 0; y < BUTTON_MATRIX_PIN_NUMOF; y++) {
+        for (unsigned k = 0; k < BUTTON_MATRIX_PIN_NUMOF; k++) {
+            if (reach[y] & (1U << k)) {
+                ghosts[y] |= reach[k];
             }
-            pos++;
         }
     }
 
-    gpio_ll_switch_dir_input(BUTTON_MATRIX_PORT, button_dir_mask_all);
+    for (unsigned y = 0; y < BUTTON_MATRIX_PIN_NUMOF; y++) {
+        reach[y] &= ~ghosts[y];
+    }
+
+    pins_to_scan(scan, reach);
+}
+
+void button_matrix_scan_without_ghosts(uint8_t *dest)
+{
+    button_matrix_scan(dest);
+    button_matrix_remove_ghosts(dest);
 }
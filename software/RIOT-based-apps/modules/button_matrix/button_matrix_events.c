@@ -0,0 +1,333 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_button_matrix_events
+ * @{
+ *
+ * @file
+ * @brief       Background scanning, debouncing and event queue for the
+ *              button matrix
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "atomic_utils.h"
+#include "button_matrix.h"
+#include "button_matrix_events.h"
+#include "button_matrix_params.h"
+#include "irq.h"
+#include "mutex.h"
+#include "periph/timer.h"
+
+#if MODULE_BUTTON_MATRIX_RECORD
+#  include "button_matrix_script.h"
+#endif
+
+#if MODULE_LED_MATRIX_LATENCY
+#  include "led_matrix_latency.h"
+#endif
+
+#if MODULE_STDIO_FB_LOG
+#  include "stdio_fb_log.h"
+#endif
+
+#if MODULE_BUTTON_MATRIX_EVENTS_LED
+#  include "led_matrix.h"
+#  define SCAN_PERIOD_US    (CONFIG_BUTTON_MATRIX_EVENTS_LED_FRAMES * 1000000UL / LED_MATRIX_FPS)
+#else
+#  ifndef BUTTON_MATRIX_EVENTS_TIMER
+#    error "BUTTON_MATRIX_EVENTS_TIMER not defined"
+#  endif
+#  define SCAN_PERIOD_US    CONFIG_BUTTON_MATRIX_EVENTS_PERIOD_US
+#endif
+
+#define BTN_BYTES           ((BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8)
+#define QUEUE_MASK          (CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE - 1)
+#define LONG_PRESS_SCANS    (CONFIG_BUTTON_MATRIX_EVENTS_LONG_PRESS_MS * 1000UL / SCAN_PERIOD_US)
+
+static_assert((CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE & QUEUE_MASK) == 0,
+              "CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE must be a power of two");
+static_assert(CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE <= 128,
+              "CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE too large for 8 bit indices");
+static_assert(LONG_PRESS_SCANS <= UINT16_MAX, "long press time too long");
+static_assert((CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS == 1)
+              || (CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS == 2)
+              || (CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS == 4),
+              "CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS must be 1, 2, or 4");
+
+/* debounced state and up to two bit vertical counters per button */
+static uint8_t state[BTN_BYTES];
+#if CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS > 1
+static uint8_t ct0[BTN_BYTES] = { [0 ... BTN_BYTES - 1] = 0xff };
+#endif
+#if CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS > 2
+static uint8_t ct1[BTN_BYTES] = { [0 ... BTN_BYTES - 1] = 0xff };
+#endif
+/* buttons for which a long press has been reported */
+static uint8_t long_reported[BTN_BYTES];
+static uint16_t pressed_at[BUTTON_MATRIX_BUTTON_NUMOF];
+static uint16_t scans;
+
+/* single producer (ISR), single consumer (thread) ring buffer */
+static button_matrix_event_t queue[CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE];
+static uint8_t queue_head;
+static uint8_t queue_tail;
+static uint32_t dropped;
+static mutex_t event_signal = MUTEX_INIT_LOCKED;
+
+#if MODULE_LED_MATRIX_LATENCY
+/* buttons seen pressed by a raw scan, but not (yet) debounced, and when */
+static uint8_t seen[BTN_BYTES];
+static uint32_t seen_at[BUTTON_MATRIX_BUTTON_NUMOF];
+
+static void track_first_seen(const uint8_t *scan)
+{
+    for (unsigned i = 0; i < BTN_BYTES; i++) {
+        uint8_t first = scan[i] & ~state[i] & ~seen[i];
+        /* forget about glitches that vanished before being debounced */
+        seen[i] = (seen[i] | first) & (scan[i] | state[i]);
+        for (unsigned bit = 0; first; bit++, first >>= 1) {
+            if (first & 0x1) {
+                seen_at[(i << 3) + bit] = led_matrix_latency_now();
+            }
+        }
+    }
+}
+#endif
+
+static void push(uint8_t button, uint8_t type, uint32_t timestamp)
+{
+    uint8_t head = queue_head;
+    if ((uint8_t)(head - atomic_load_u8(&queue_tail)) >= CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE) {
+        dropped++;
+#if MODULE_STDIO_FB_LOG
+        stdio_fb_log(STDIO_FB_LOG_CTX_ISR, "btn events lost", dropped);
+#endif
+        return;
+    }
+
+    button_matrix_event_t *event = &queue[head & QUEUE_MASK];
+    event->timestamp = timestamp;
+    event->button = button;
+    event->type = type;
+    /* publish the event only after it has been written */
+    atomic_store_u8(&queue_head, head + 1);
+}
+
+void button_matrix_events_feed(const uint8_t *scan, uint32_t timestamp)
+{
+    bool pushed = false;
+    scans++;
+
+#if MODULE_LED_MATRIX_LATENCY
+    track_first_seen(scan);
+#endif
+
+    for (unsigned i = 0; i < BTN_BYTES; i++) {
+        uint8_t delta = scan[i] ^ state[i];
+#if CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS == 4
+        /* count down the vertical counters of buttons differing from the
+         * debounced state, reset all others. A button toggles once its
+         * counter wraps, i.e. after the four consecutive scans configured in
+         * CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS */
+        ct0[i] = ~(ct0[i] & delta);
+        ct1[i] = ct0[i] ^ (ct1[i] & delta);
+        uint8_t toggled = delta & ct0[i] & ct1[i];
+#elif CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS == 2
+        /* toggle when differing in this and the previous scan */
+        uint8_t toggled = delta & ~ct0[i];
+        ct0[i] = ~delta | toggled;
+#else
+        uint8_t toggled = delta;
+#endif
+        state[i] ^= toggled;
+        long_reported[i] &= state[i];
+#if MODULE_LED_MATRIX_LATENCY
+        seen[i] &= ~toggled;
+#endif
+
+        uint8_t held = state[i] & ~long_reported[i];
+        if (!(toggled | held)) {
+            continue;
+        }
+
+        for (unsigned bit = 0; bit < 8; bit++) {
+            uint8_t mask = 1U << bit;
+            unsigned btn = (i << 3) + bit;
+            if (toggled & mask) {
+                if (state[i] & mask) {
+                    pressed_at[btn] = scans;
+                    push(btn, BUTTON_MATRIX_EVENT_PRESS, timestamp);
+                }
+                else {
+                    push(btn, BUTTON_MATRIX_EVENT_RELEASE, timestamp);
+                }
+                pushed = true;
+            }
+            else if ((held & mask) && ((uint16_t)(scans - pressed_at[btn]) >= LONG_PRESS_SCANS)) {
+                long_reported[i] |= mask;
+                push(btn, BUTTON_MATRIX_EVENT_LONG_PRESS, timestamp);
+                pushed = true;
+            }
+        }
+    }
+
+    if (pushed) {
+        mutex_unlock(&event_signal);
+    }
+}
+
+bool button_matrix_events_try_get(button_matrix_event_t *event)
+{
+    uint8_t tail = queue_tail;
+    if (atomic_load_u8(&queue_head) == tail) {
+        return false;
+    }
+
+    *event = queue[tail & QUEUE_MASK];
+    /* release the slot only after it has been read */
+    atomic_store_u8(&queue_tail, tail + 1);
+
+#if MODULE_LED_MATRIX_LATENCY
+    if (event->type == BUTTON_MATRIX_EVENT_PRESS) {
+        led_matrix_latency_start(atomic_load_u32(&seen_at[event->button]));
+    }
+#endif
+
+    return true;
+}
+
+bool button_matrix_events_pending(void)
+{
+    return atomic_load_u8(&queue_head) != queue_tail;
+}
+
+void button_matrix_events_get(button_matrix_event_t *event)
+{
+    /* the mutex is used as a signal: the ISR unlocks it whenever new
+     * events have been pushed */
+    while (!button_matrix_events_try_get(event)) {
+#if MODULE_LED_MATRIX_HEADLESS
+        /* there is no ISR, scanning happens when advancing frames */
+        led_matrix_wait_for_frame(led_matrix_frame_number() + 1);
+#else
+        mutex_lock(&event_signal);
+#endif
+    }
+}
+
+void button_matrix_events_flush(void)
+{
+    atomic_store_u8(&queue_tail, atomic_load_u8(&queue_head));
+}
+
+bool button_matrix_events_pressed(void)
+{
+    button_matrix_event_t event;
+    bool pressed = false;
+
+    while (button_matrix_events_try_get(&event)) {
+        pressed |= (event.type == BUTTON_MATRIX_EVENT_PRESS);
+    }
+
+    return pressed;
+}
+
+void button_matrix_events_state(uint8_t *dest)
+{
+    unsigned irq_state = irq_disable();
+    memcpy(dest, state, sizeof(state));
+    irq_restore(irq_state);
+}
+
+void button_matrix_events_wait_for_release(void)
+{
+    uint8_t pressed[BTN_BYTES];
+    static const uint8_t released[BTN_BYTES];
+
+    while (1) {
+        button_matrix_events_state(pressed);
+        if (!memcmp(pressed, released, sizeof(pressed))) {
+            return;
+        }
+
+        /* the state changes only along with new events */
+        button_matrix_event_t event;
+        button_matrix_events_get(&event);
+    }
+}
+
+uint32_t button_matrix_events_dropped(void)
+{
+    return atomic_load_u32(&dropped);
+}
+
+#if MODULE_BUTTON_MATRIX_EVENTS_LED
+bool button_matrix_events_scan_step(uint32_t timestamp)
+{
+    static uint8_t column;
+    static uint8_t scan[BTN_BYTES];
+
+    if (column == 0) {
+        memset(scan, 0, sizeof(scan));
+    }
+    else {
+        button_matrix_read_column(scan, column - 1);
+    }
+
+    if (column < BUTTON_MATRIX_HEIGHT) {
+        button_matrix_drive_column(column++);
+        return true;
+    }
+
+    button_matrix_release();
+    column = 0;
+#if MODULE_BUTTON_MATRIX_RECORD
+    button_matrix_record_scan(scan);
+#endif
+    button_matrix_remove_ghosts(scan);
+    button_matrix_events_feed(scan, timestamp);
+    return false;
+}
+
+int button_matrix_events_init(void)
+{
+    /* scanning is driven by the LED matrix ISR */
+    return 0;
+}
+#else /* MODULE_BUTTON_MATRIX_EVENTS_LED */
+static void scan_timer_cb(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    static uint32_t scan_number;
+    uint8_t scan[BTN_BYTES];
+
+    button_matrix_scan_without_ghosts(scan);
+    button_matrix_events_feed(scan, ++scan_number);
+}
+
+int button_matrix_events_init(void)
+{
+    const uint32_t timer_freq = 1000000;
+    int retval = timer_init(BUTTON_MATRIX_EVENTS_TIMER, timer_freq, scan_timer_cb, NULL);
+    if (retval != 0) {
+        return retval;
+    }
+
+    return timer_set_periodic(BUTTON_MATRIX_EVENTS_TIMER, 0,
+                              CONFIG_BUTTON_MATRIX_EVENTS_PERIOD_US,
+                              TIM_FLAG_RESET_ON_MATCH | TIM_FLAG_RESET_ON_SET);
+}
+#endif /* MODULE_BUTTON_MATRIX_EVENTS_LED */
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_button_matrix_script
+ * @{
+ *
+ * @file
+ * @brief       Recording of button input as script
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "button_matrix_params.h"
+#include "button_matrix_script.h"
+#include "irq.h"
+#include "led_matrix.h"
+
+static_assert(BUTTON_MATRIX_BUTTON_NUMOF <= 8,
+              "scripts only support matrices of up to 8 buttons");
+
+static button_matrix_script_step_t recording[CONFIG_BUTTON_MATRIX_RECORD_STEPS_MAX];
+static size_t recording_numof;
+static uint32_t recording_start;
+static uint8_t last;
+static bool recording_active;
+static bool overflowed;
+
+void button_matrix_record_start(void)
+{
+    unsigned irq_state = irq_disable();
+    recording_numof = 0;
+    recording_start = led_matrix_frame_number();
+    last = 0;
+    overflowed = false;
+    recording_active = true;
+    irq_restore(irq_state);
+}
+
+void button_matrix_record_scan(const uint8_t *scan)
+{
+    if (!recording_active || (scan[0] == last)) {
+        return;
+    }
+
+    if (recording_numof >= CONFIG_BUTTON_MATRIX_RECORD_STEPS_MAX) {
+        overflowed = true;
+        recording_active = false;
+        return;
+    }
+
+    last = scan[0];
+    recording[recording_numof++] = (button_matrix_script_step_t) {
+        .frame = led_matrix_frame_number() - recording_start,
+        .scan = last,
+    };
+}
+
+size_t button_matrix_record_get(const button_matrix_script_step_t **steps)
+{
+    *steps = recording;
+    unsigned irq_state = irq_disable();
+    size_t numof = recording_numof;
+    irq_restore(irq_state);
+    return numof;
+}
+
+bool button_matrix_record_overflowed(void)
+{
+    unsigned irq_state = irq_disable();
+    bool retval = overflowed;
+    irq_restore(irq_state);
+    return retval;
+}
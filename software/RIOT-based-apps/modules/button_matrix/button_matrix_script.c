@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_button_matrix_script
+ * @{
+ *
+ * @file
+ * @brief       Playback of scripted button input
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "atomic_utils.h"
+#include "button_matrix_params.h"
+#include "button_matrix_script.h"
+#include "irq.h"
+#include "led_matrix.h"
+
+static_assert(BUTTON_MATRIX_BUTTON_NUMOF <= 8,
+              "scripts only support matrices of up to 8 buttons");
+
+static const button_matrix_script_step_t *script;
+static size_t script_numof;
+static size_t script_pos;
+static uint32_t script_start;
+static uint8_t current;
+
+void button_matrix_script_start(const button_matrix_script_step_t *steps, size_t numof)
+{
+    unsigned irq_state = irq_disable();
+    script = steps;
+    script_numof = numof;
+    script_pos = 0;
+    script_start = led_matrix_frame_number();
+    current = 0;
+    irq_restore(irq_state);
+}
+
+uint8_t button_matrix_script_scan(void)
+{
+    uint32_t now = led_matrix_frame_number() - script_start;
+
+    /* time only moves forward, so the steps are visited only once */
+    while ((script_pos < script_numof) && (script[script_pos].frame <= now)) {
+        current = script[script_pos++].scan;
+    }
+
+    return current;
+}
+
+bool button_matrix_script_done(void)
+{
+    unsigned irq_state = irq_disable();
+    bool done = (script_pos >= script_numof);
+    irq_restore(irq_state);
+    return done;
+}
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""
+Generate the lookup tables mapping every scan of a button matrix to the
+smallest set of pressed buttons explaining it, i.e. with the ghost readings
+due to rollover removed. The tables only depend on the number of pins, so
+they are generated for all matrices with up to the given number of buttons.
+
+The bit order of the buttons is the one of button_matrix_scan().
+"""
+
+from argparse import ArgumentParser
+from os.path import basename
+
+
+def btn_pos(pins, y, x):
+    """Position of the button connecting driven pin y with read pin x"""
+    pos = y * (pins - 1) + (pins - 1 - x)
+    return pos - 1 if x < y else pos
+
+
+def scan_to_pins(pins, scan):
+    """Convert a scan into a bitmask of pins reachable for each driven pin"""
+    reach = [0] * pins
+    for y in range(pins):
+        for x in range(pins):
+            if (x != y) and (scan & (1 << btn_pos(pins, y, x))):
+                reach[y] |= 1 << x
+    return reach
+
+
+def pins_to_scan(pins, reach):
+    scan = 0
+    for y in range(pins):
+        for x in range(pins):
+            if (x != y) and (reach[y] & (1 << x)):
+                scan |= 1 << btn_pos(pins, y, x)
+    return scan
+
+
+def ghost_closure(pins, pressed):
+    """The buttons read when the given buttons are pressed: driving a pin
+    reaches every pin connected via a chain of pressed buttons"""
+    reach = scan_to_pins(pins, pressed)
+    for k in range(pins):
+        for y in range(pins):
+            if reach[y] & (1 << k):
+                reach[y] |= reach[k]
+    return pins_to_scan(pins, reach)
+
+
+def ghost_lut(pins):
+    buttons = pins * (pins - 1)
+    lut = [None] * (1 << buttons)
+    # visiting candidates in order of increasing number of buttons, the
+    # first match is the smallest one
+    for pressed in sorted(range(1 << buttons), key=lambda p: bin(p).count("1")):
+        ghosts = ghost_closure(pins, pressed) & ~pressed
+        sub = 0
+        while True:
+            if lut[pressed | sub] is None:
+                lut[pressed | sub] = pressed
+            sub = (sub - ghosts) & ghosts
+            if sub == 0:
+                break
+    return lut
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description="Generate the ghost removal tables")
+    parser.add_argument("--buttons-max", type=int, default=8,
+                        help="largest number of buttons to generate a table for")
+    args = parser.parse_args()
+
+    pins_max = 2
+    while (pins_max + 1) * pins_max <= args.buttons_max:
+        pins_max += 1
+
+    print(f"/* This file is auto generated using {basename(parser.prog)} */")
+    print(f"#define GHOST_LUT_PINS_MAX  {pins_max}\n")
+    for pins in range(2, pins_max + 1):
+        lut = ghost_lut(pins)
+        print(f"static const uint8_t ghost_lut_{pins}[{len(lut)}] = {{")
+        for i in range(0, len(lut), 8):
+            print("    " + ", ".join(f"{v:#04x}" for v in lut[i:i + 8]) + ",")
+        print("};\n")
+    print("/* indexed by the number of pins */")
+    print("static const uint8_t * const ghost_luts[] = {")
+    print("    NULL,\n    NULL,")
+    for pins in range(2, pins_max + 1):
+        print(f"    ghost_lut_{pins},")
+    print("};")
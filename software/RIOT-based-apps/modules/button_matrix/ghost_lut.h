@@ -0,0 +1,25 @@
+/* This file is auto generated using ghost_lut.py */
+#define GHOST_LUT_PINS_MAX  3
+
+static const uint8_t ghost_lut_2[4] = {
+    0x00, 0x01, 0x02, 0x03,
+};
+
+static const uint8_t ghost_lut_3[64] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x06,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x09, 0x0e, 0x0b,
+    0x10, 0x11, 0x12, 0x11, 0x14, 0x15, 0x16, 0x15,
+    0x18, 0x19, 0x1a, 0x19, 0x1c, 0x19, 0x1e, 0x19,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x26,
+    0x28, 0x29, 0x2a, 0x2b, 0x24, 0x25, 0x26, 0x26,
+    0x30, 0x31, 0x22, 0x23, 0x34, 0x35, 0x26, 0x26,
+    0x18, 0x19, 0x1a, 0x19, 0x1c, 0x19, 0x26, 0x19,
+};
+
+/* indexed by the number of pins */
+static const uint8_t * const ghost_luts[] = {
+    NULL,
+    NULL,
+    ghost_lut_2,
+    ghost_lut_3,
+};
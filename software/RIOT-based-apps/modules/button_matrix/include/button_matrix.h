@@ -67,11 +67,60 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Use a lookup table for ghost removal for matrices of up to this
+ *          number of buttons
+ *
+ * The table has one byte per possible scan result, i.e. 64 bytes of flash for
+ * six buttons. The tables are generated at development time for matrices of
+ * up to eight buttons by `dist/ghost_lut.py`, larger matrices fall back to
+ * computing the ghosts on every scan.
+ */
+#ifndef CONFIG_BUTTON_MATRIX_GHOST_LUT_BUTTONS_MAX
+#  define CONFIG_BUTTON_MATRIX_GHOST_LUT_BUTTONS_MAX    8
+#endif
+
+/**
+ * @brief   Safety margin in percent added to the measured settle time
+ */
+#ifndef CONFIG_BUTTON_MATRIX_SETTLE_MARGIN_PERCENT
+#  define CONFIG_BUTTON_MATRIX_SETTLE_MARGIN_PERCENT    100
+#endif
+
+/**
+ * @brief   Number of dummy GPIO reads to wait for the inputs to settle after
+ *          driving a column
+ *
+ * This is used until the settle time has been measured, and is the upper
+ * bound of the measured value.
+ */
+#ifndef CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX
+#  define CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX         8
+#endif
+
+/**
+ * @brief   Coordinates of a button as used by @ref button_matrix_test
+ */
+typedef struct {
+    uint8_t x;      /**< X coordinate */
+    uint8_t y;      /**< Y coordinate */
+} button_matrix_coord_t;
+
 /**
  * @brief   Prepares the button matrix for sampling
  *
  * @retval  0       Success
  * @retval  <0      Configuring the GPIOs failed, error code is passed through
+ *
+ * The time a driven column takes to show up at the input is measured through
+ * the first button seen pressed by @ref button_matrix_scan or
+ * @ref button_matrix_test_batch. The result plus
+ * @ref CONFIG_BUTTON_MATRIX_SETTLE_MARGIN_PERCENT is used for all subsequent
+ * tests and scans, until then @ref CONFIG_BUTTON_MATRIX_SETTLE_READS_MAX dummy
+ * reads are used. With module `flash_kv` the result is stored, and loaded
+ * again here on the next boot.
+ *
+ * With module `button_matrix_events` this also starts the background scanner.
  */
 int button_matrix_init(void);
 
@@ -83,6 +132,20 @@ int button_matrix_init(void);
  */
 bool button_matrix_test(uint8_t x, uint8_t y);
 
+/**
+ * @brief   Read out the button state at several positions at once
+ *
+ * @param[in]   coords  The positions to test
+ * @param[in]   numof   Number of entries in @p coords
+ * @param[out]  dest    Bit vector of @p numof bits to write the results to,
+ *                      bit `i` is set if the button at `coords[i]` is pressed
+ *                      (or rollover)
+ *
+ * Each column is driven at most once, so testing all buttons costs the same
+ * as @ref button_matrix_scan, rather than one drive phase per button.
+ */
+void button_matrix_test_batch(const button_matrix_coord_t *coords, size_t numof, uint8_t *dest);
+
 /**
  * @brief   Scan the whole button matrix and write the result
  *
@@ -90,6 +153,79 @@ bool button_matrix_test(uint8_t x, uint8_t y);
  */
 void button_matrix_scan(uint8_t *dest);
 
+/**
+ * @brief   Remove ghost readings due to rollover from a scan
+ *
+ * @param[in,out]   scan    The output of @ref button_matrix_scan to fix up
+ *
+ * Driving a pin also reaches every pin connected via a chain of pressed
+ * buttons, so that additional buttons may be reported. The scan is replaced
+ * by the smallest set of buttons that would result in the same reading.
+ * E.g. pressing two buttons that share a pin can result in a third button
+ * being reported, which is removed again.
+ *
+ * For matrices with up to @ref CONFIG_BUTTON_MATRIX_GHOST_LUT_BUTTONS_MAX
+ * buttons this is a single table lookup. Otherwise every button reachable
+ * via two pressed buttons is removed.
+ *
+ * @note    When three or more buttons are pressed at once, the readings
+ *          can be ambiguous.
+ */
+void button_matrix_remove_ghosts(uint8_t *scan);
+
+/**
+ * @brief   Same as @ref button_matrix_scan, but with ghost readings removed
+ *          using @ref button_matrix_remove_ghosts
+ *
+ * @param[out]  dest    The bit vector to write the input to
+ */
+void button_matrix_scan_without_ghosts(uint8_t *dest);
+
+/**
+ * @name    Building blocks for scanning interleaved with other work
+ *
+ * @ref button_matrix_scan busy-waits for the input buffers to settle after
+ * driving each column. Callers that are invoked periodically anyway (e.g.
+ * an ISR) can instead drive a column, return, and read it at the next
+ * invocation:
+ *
+ * ```C
+ * memset(dest, 0, (BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8);
+ * for (unsigned y = 0; y < BUTTON_MATRIX_HEIGHT; y++) {
+ *     button_matrix_drive_column(y);
+ *     // ... do something else for a few microseconds ...
+ *     button_matrix_read_column(dest, y);
+ * }
+ * button_matrix_release();
+ * ```
+ * @{
+ */
+/**
+ * @brief   Drive the given column of the button matrix high and all other
+ *          pins to input
+ *
+ * @param[in]   y       The column to drive
+ */
+void button_matrix_drive_column(unsigned y);
+
+/**
+ * @brief   Read the buttons of the currently driven column into @p dest
+ *
+ * @param[out]  dest    The bit vector to add the pressed buttons to (in the
+ *                      same format as @ref button_matrix_scan)
+ * @param[in]   y       The column currently driven
+ *
+ * @pre     @ref button_matrix_drive_column has been called for @p y and the
+ *          inputs had time to settle
+ */
+void button_matrix_read_column(uint8_t *dest, unsigned y);
+
+/**
+ * @brief   Switch all pins of the button matrix back to input
+ */
+void button_matrix_release(void);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
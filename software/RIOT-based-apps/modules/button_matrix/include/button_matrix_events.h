@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    drivers_button_matrix_events  Debounced Button Events
+ * @ingroup     drivers_button_matrix
+ *
+ * With module `button_matrix_events` the button matrix is scanned
+ * periodically in the background by a timer ISR. Every button is debounced
+ * individually: A change is only accepted after
+ * @ref CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS consecutive scans agree
+ * (two with `button_matrix_events_led`, four otherwise). Ghost readings due
+ * to rollover are removed before debouncing.
+ * Press, release, and long-press events are pushed into a lock-free queue,
+ * so that applications can block until the next event arrives instead of
+ * polling.
+ *
+ * The board configuration needs to provide the timer to use:
+ *
+ * ```C
+ * #define BUTTON_MATRIX_EVENTS_TIMER   TIMER_DEV(x)
+ * ```
+ *
+ * The background scanner is started by @ref button_matrix_init.
+ *
+ * Alternatively, with module `button_matrix_events_led` the buttons are
+ * scanned by the refresh ISR of the LED matrix every
+ * @ref CONFIG_BUTTON_MATRIX_EVENTS_LED_FRAMES frames, so that no additional
+ * timer is needed. The scan is spread over consecutive invocations of the
+ * ISR (one column per pixel), so it needs no busy waiting for the inputs to
+ * settle. The events are timestamped with the LED matrix frame number and
+ * scanning starts with @ref led_matrix_init.
+ *
+ * @warning     With this module in use, @ref button_matrix_scan and
+ *              @ref button_matrix_test must not be called by the application,
+ *              as they would race with the background scanner.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `button_matrix_events` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef BUTTON_MATRIX_EVENTS_H
+#define BUTTON_MATRIX_EVENTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Period of the background scan in microseconds
+ *
+ * A button press is reported no later than
+ * @ref CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS periods after the contacts
+ * settled.
+ */
+#ifndef CONFIG_BUTTON_MATRIX_EVENTS_PERIOD_US
+#  define CONFIG_BUTTON_MATRIX_EVENTS_PERIOD_US     2500
+#endif
+
+/**
+ * @brief   Scan the buttons every n-th LED matrix frame (with module
+ *          `button_matrix_events_led`)
+ */
+#ifndef CONFIG_BUTTON_MATRIX_EVENTS_LED_FRAMES
+#  define CONFIG_BUTTON_MATRIX_EVENTS_LED_FRAMES    1
+#endif
+
+/**
+ * @brief   Number of consecutive scans that need to agree to accept a
+ *          change of a button (1, 2, or 4)
+ *
+ * Defaults to 4 for the timer based scanner and 2 for the slower scanning in
+ * the LED matrix ISR (60 Hz by default).
+ */
+#ifndef CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS
+#  if MODULE_BUTTON_MATRIX_EVENTS_LED
+#    define CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS  2
+#  else
+#    define CONFIG_BUTTON_MATRIX_EVENTS_DEBOUNCE_SCANS  4
+#  endif
+#endif
+
+/**
+ * @brief   Time in milliseconds a button needs to be held to generate a
+ *          @ref BUTTON_MATRIX_EVENT_LONG_PRESS event
+ */
+#ifndef CONFIG_BUTTON_MATRIX_EVENTS_LONG_PRESS_MS
+#  define CONFIG_BUTTON_MATRIX_EVENTS_LONG_PRESS_MS 1000
+#endif
+
+/**
+ * @brief   Number of events the queue can hold (must be a power of two)
+ *
+ * When the queue is full, new events are dropped.
+ */
+#ifndef CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE
+#  define CONFIG_BUTTON_MATRIX_EVENTS_QUEUE_SIZE    8
+#endif
+
+/**
+ * @brief   Types of button events
+ */
+typedef enum {
+    BUTTON_MATRIX_EVENT_PRESS,          /**< Button was pressed */
+    BUTTON_MATRIX_EVENT_RELEASE,        /**< Button was released */
+    BUTTON_MATRIX_EVENT_LONG_PRESS,     /**< Button is held for a long time */
+} button_matrix_event_type_t;
+
+/**
+ * @brief   A button event
+ */
+typedef struct {
+    uint32_t timestamp;                 /**< Number of the scan that detected the event, or
+                                             the LED matrix frame number with module
+                                             `button_matrix_events_led` */
+    uint8_t button;                     /**< Bit position of the button in the output of
+                                             @ref button_matrix_scan */
+    uint8_t type;                       /**< Type of the event, see
+                                             @ref button_matrix_event_type_t */
+} button_matrix_event_t;
+
+/**
+ * @brief   Start the background scanner
+ *
+ * @retval  0       Success
+ * @retval  <0      Configuring the timer failed, error code is passed through
+ *
+ * @note    This is called by @ref button_matrix_init
+ */
+int button_matrix_events_init(void);
+
+/**
+ * @brief   Feed the result of a scan into the debouncer
+ *
+ * @param[in]   scan        The output of @ref button_matrix_scan
+ * @param[in]   timestamp   Timestamp to attach to the resulting events
+ *
+ * This is called by the background scanner from interrupt context.
+ */
+void button_matrix_events_feed(const uint8_t *scan, uint32_t timestamp);
+
+/**
+ * @brief   Perform the next step of a scan interleaved with other work
+ *
+ * @param[in]   timestamp   Timestamp to attach to the resulting events
+ *
+ * @retval  true    Call again after the inputs had time to settle
+ * @retval  false   The scan is complete and fed into the debouncer
+ *
+ * This is called by the LED matrix ISR with module `button_matrix_events_led`.
+ */
+bool button_matrix_events_scan_step(uint32_t timestamp);
+
+/**
+ * @brief   Get the next button event, if any
+ *
+ * @param[out]  event       The event to write
+ *
+ * @retval  true    An event was written to @p event
+ * @retval  false   No event is pending
+ */
+bool button_matrix_events_try_get(button_matrix_event_t *event);
+
+/**
+ * @brief   Check if an event is pending, without taking it
+ *
+ * @retval  true    @ref button_matrix_events_try_get would return an event
+ * @retval  false   No event is pending
+ */
+bool button_matrix_events_pending(void);
+
+/**
+ * @brief   Block until the next button event is available and get it
+ *
+ * @param[out]  event       The event to write
+ */
+void button_matrix_events_get(button_matrix_event_t *event);
+
+/**
+ * @brief   Drop all pending events
+ */
+void button_matrix_events_flush(void);
+
+/**
+ * @brief   Take all pending events and check if a button was pressed
+ *
+ * @retval  true    At least one of the events taken was a press
+ * @retval  false   No button was pressed since the last call
+ */
+bool button_matrix_events_pressed(void);
+
+/**
+ * @brief   Get the current debounced state of the buttons
+ *
+ * @param[out]  dest    The bit vector to write the state to, in the same
+ *                      format as @ref button_matrix_scan
+ */
+void button_matrix_events_state(uint8_t *dest);
+
+/**
+ * @brief   Block until all buttons are released (after debouncing)
+ */
+void button_matrix_events_wait_for_release(void);
+
+/**
+ * @brief   Get the number of events dropped due to the queue being full
+ */
+uint32_t button_matrix_events_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUTTON_MATRIX_EVENTS_H */
+/** @} */
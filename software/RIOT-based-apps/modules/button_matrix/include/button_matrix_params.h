@@ -25,7 +25,17 @@
 extern "C" {
 #endif
 
-#ifndef BUTTON_MATRIX_PORT
+#if MODULE_BUTTON_MATRIX_SCRIPT && !defined(BUTTON_MATRIX_PIN_0)
+/* Without real hardware (e.g. on the native board), default to the wiring of
+ * the business card */
+#  define BUTTON_MATRIX_PIN_0       0
+#  define BUTTON_MATRIX_PIN_1       1
+#  define BUTTON_MATRIX_PIN_2       2
+
+#  include "business_card_buttons.h"
+#endif
+
+#if !defined(BUTTON_MATRIX_PORT) && !MODULE_BUTTON_MATRIX_SCRIPT
 #  error "BUTTON_MATRIX_PORT not defined"
 #endif
 
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    drivers_button_matrix_script  Scripted Button Input
+ * @ingroup     drivers_button_matrix
+ *
+ * With module `button_matrix_script` the button matrix is not read from the
+ * GPIOs, but from a script of button states keyed by LED matrix frame
+ * numbers. All of the `button_matrix` API (including the background
+ * scanning of `button_matrix_events`) works unchanged on top of it, which
+ * allows running the games with reproducible input, e.g. on the `native`
+ * board (where this module is selected automatically).
+ *
+ * Without board configuration, the wiring of the business card and its
+ * `BUTTON_*` masks are assumed.
+ *
+ * ```C
+ * static const button_matrix_script_step_t script[] = {
+ *     { .frame = 30, .scan = BUTTON_A },   // press A at frame 30 ...
+ *     { .frame = 33, .scan = 0 },          // ... and release it 3 frames later
+ * };
+ *
+ * button_matrix_script_start(script, ARRAY_SIZE(script));
+ * ```
+ *
+ * @note    Scripted presses are reported without rollover ghosts.
+ *
+ * With module `button_matrix_record`, the results of
+ * @ref button_matrix_scan (and of the background scans of
+ * `button_matrix_events`) are recorded in the same format instead, so that
+ * a session with real buttons can be played back later. Only changes are
+ * stored.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `button_matrix_script` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef BUTTON_MATRIX_SCRIPT_H
+#define BUTTON_MATRIX_SCRIPT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A change of the button state in a script
+ */
+typedef struct {
+    uint32_t frame;     /**< Frame number relative to the start of the script */
+    uint8_t scan;       /**< Buttons pressed from then on, in the format of
+                             @ref button_matrix_scan */
+} button_matrix_script_step_t;
+
+/**
+ * @brief   Start playing back the given script
+ *
+ * @param[in]   steps   The steps of the script, sorted by frame number.
+ *                      Must remain valid while the script is playing.
+ * @param[in]   numof   Number of entries in @p steps
+ *
+ * No button is pressed until the first step is reached. After the last
+ * step, its state remains.
+ */
+void button_matrix_script_start(const button_matrix_script_step_t *steps, size_t numof);
+
+/**
+ * @brief   Get the button state the script defines for the current frame
+ *
+ * @note    This is what the button matrix driver reads instead of the
+ *          GPIOs. It is not meant to be called concurrently with scanning.
+ */
+uint8_t button_matrix_script_scan(void);
+
+/**
+ * @brief   Check if all steps of the script have been played back
+ */
+bool button_matrix_script_done(void);
+
+/**
+ * @name    Recording scripts
+ * @{
+ */
+/**
+ * @brief   Maximum number of steps to record
+ *
+ * Each step takes 8 bytes of RAM. Recording stops when full.
+ */
+#ifndef CONFIG_BUTTON_MATRIX_RECORD_STEPS_MAX
+#  define CONFIG_BUTTON_MATRIX_RECORD_STEPS_MAX 128
+#endif
+
+/**
+ * @brief   Start recording, frame numbers of the recorded steps are relative
+ *          to now
+ *
+ * Anything recorded so far is dropped.
+ */
+void button_matrix_record_start(void);
+
+/**
+ * @brief   Add a scan to the recording
+ *
+ * @param[in]   scan    The result of a scan, in the format of
+ *                      @ref button_matrix_scan
+ *
+ * @note    Called by the button matrix driver for every full scan
+ */
+void button_matrix_record_scan(const uint8_t *scan);
+
+/**
+ * @brief   Get the steps recorded so far
+ *
+ * @param[out]  steps   Pointer to the recorded steps
+ *
+ * @return  The number of steps recorded
+ */
+size_t button_matrix_record_get(const button_matrix_script_step_t **steps);
+
+/**
+ * @brief   Check if the recording stopped because
+ *          @ref CONFIG_BUTTON_MATRIX_RECORD_STEPS_MAX steps were exceeded
+ */
+bool button_matrix_record_overflowed(void);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUTTON_MATRIX_SCRIPT_H */
+/** @} */
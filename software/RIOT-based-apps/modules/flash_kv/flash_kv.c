@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_flash_kv
+ * @{
+ *
+ * @file
+ * @brief       Log-structured key/value store
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "flash_kv.h"
+#include "flash_kv_backend.h"
+
+#define BLOCK_SIZE          8U
+#define HEADER_MAGIC        0x31564b46UL    /* "FKV1" in little endian */
+/* bytes of the value stored in the first block of a record */
+#define FIRST_BLOCK_VALUE   4U
+#define RECORD_MAX          (((FIRST_BLOCK_VALUE + CONFIG_FLASH_KV_VALUE_MAX + BLOCK_SIZE - 1) \
+                              / BLOCK_SIZE) * BLOCK_SIZE)
+/* key of erased flash, never used */
+#define KEY_ERASED          0xffU
+
+static_assert(CONFIG_FLASH_KV_VALUE_MAX <= UINT8_MAX,
+              "CONFIG_FLASH_KV_VALUE_MAX must fit the length field");
+static_assert(CONFIG_FLASH_KV_KEYS < KEY_ERASED,
+              "CONFIG_FLASH_KV_KEYS too large");
+static_assert(FLASH_KV_PAGE_SIZE <= UINT16_MAX, "offsets must fit the index");
+
+struct page_header {
+    uint32_t magic;
+    uint16_t seq;
+    uint16_t seq_inv;
+};
+
+struct record_header {
+    uint8_t key;
+    uint8_t len;
+    uint16_t crc;
+    uint8_t value[FIRST_BLOCK_VALUE];
+};
+
+static_assert(sizeof(struct page_header) == BLOCK_SIZE, "page header must be a block");
+static_assert(sizeof(struct record_header) == BLOCK_SIZE, "record header must be a block");
+
+/* offset of the latest record of every key in the active page, 0 if none */
+static uint16_t latest[CONFIG_FLASH_KV_KEYS];
+static uint16_t write_pos;
+static uint16_t seq;
+static uint8_t active;
+static bool mounted;
+
+/* the value continues past the first block */
+static const uint8_t *record_value(const uint8_t *record)
+{
+    return record + offsetof(struct record_header, value);
+}
+
+static size_t record_size(unsigned len)
+{
+    return (FIRST_BLOCK_VALUE + len + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+}
+
+static uint16_t record_crc(const uint8_t *record)
+{
+    const struct record_header *hdr = (const void *)record;
+    uint16_t crc = crc16_ccitt_false_update(0xffff, record, offsetof(struct record_header, crc));
+    return crc16_ccitt_false_update(crc, record_value(record), hdr->len);
+}
+
+static bool is_erased(const uint8_t *data, size_t len)
+{
+    while (len--) {
+        if (*data++ != 0xff) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool header_valid(const struct page_header *hdr)
+{
+    return (hdr->magic == HEADER_MAGIC) && ((uint16_t)(hdr->seq ^ hdr->seq_inv) == 0xffff);
+}
+
+static const uint8_t *record_at(uint16_t offset)
+{
+    return flash_kv_backend_page(active) + offset;
+}
+
+/* rebuild the index from the log in the active page */
+static void scan(void)
+{
+    const uint8_t *page = flash_kv_backend_page(active);
+    size_t pos = BLOCK_SIZE;
+
+    memset(latest, 0, sizeof(latest));
+
+    while (pos + BLOCK_SIZE <= FLASH_KV_PAGE_SIZE) {
+        const struct record_header *hdr = (const void *)&page[pos];
+        if (is_erased(&page[pos], BLOCK_SIZE)) {
+            break;
+        }
+
+        size_t size = record_size(hdr->len);
+        if (pos + size > FLASH_KV_PAGE_SIZE) {
+            /* garbage, not a record */
+            pos = FLASH_KV_PAGE_SIZE;
+            break;
+        }
+
+        if ((hdr->key < CONFIG_FLASH_KV_KEYS) && (hdr->crc == record_crc(&page[pos]))) {
+            latest[hdr->key] = pos;
+        }
+        /* else: cut short by a power loss, the previous record stays in effect */
+
+        pos += size;
+    }
+
+    /* a write cut short may have programmed blocks past the end of the log,
+     * which cannot be programmed again before erasing */
+    if (!is_erased(&page[pos], FLASH_KV_PAGE_SIZE - pos)) {
+        pos = FLASH_KV_PAGE_SIZE;
+    }
+
+    write_pos = pos;
+}
+
+static int write_header(unsigned page, uint16_t new_seq)
+{
+    const struct page_header hdr = {
+        .magic = HEADER_MAGIC,
+        .seq = new_seq,
+        .seq_inv = ~new_seq,
+    };
+
+    return flash_kv_backend_write(page, 0, &hdr, sizeof(hdr));
+}
+
+static int erase_if_needed(unsigned page)
+{
+    if (is_erased(flash_kv_backend_page(page), FLASH_KV_PAGE_SIZE)) {
+        return 0;
+    }
+
+    return flash_kv_backend_erase(page);
+}
+
+int flash_kv_init(void)
+{
+    const struct page_header *hdr[2] = {
+        (const void *)flash_kv_backend_page(0),
+        (const void *)flash_kv_backend_page(1),
+    };
+    bool valid[2] = { header_valid(hdr[0]), header_valid(hdr[1]) };
+
+    mounted = false;
+
+    if (!valid[0] && !valid[1]) {
+        /* no store yet, or power was lost while creating it */
+        int retval = erase_if_needed(0);
+        if (retval == 0) {
+            retval = write_header(0, 0);
+        }
+        if (retval != 0) {
+            return retval;
+        }
+        valid[0] = true;
+    }
+
+    if (valid[0] && valid[1]) {
+        /* the other page is left over from before the last compaction */
+        active = ((int16_t)(hdr[1]->seq - hdr[0]->seq) > 0) ? 1 : 0;
+    }
+    else {
+        active = valid[0] ? 0 : 1;
+    }
+
+    seq = hdr[active]->seq;
+    scan();
+    mounted = true;
+
+    return 0;
+}
+
+static int mount(void)
+{
+    if (mounted) {
+        return 0;
+    }
+
+    return flash_kv_init();
+}
+
+/* copy the latest records into the other page, with record replacing the one
+ * of its key */
+static int compact(const uint8_t *record)
+{
+    unsigned target = !active;
+    uint16_t new_latest[CONFIG_FLASH_KV_KEYS] = { 0 };
+    size_t pos = BLOCK_SIZE;
+    unsigned new_key = ((const struct record_header *)record)->key;
+
+    /* check if it fits before erasing anything */
+    for (unsigned key = 0; key < CONFIG_FLASH_KV_KEYS; key++) {
+        if (key == new_key) {
+            pos += record_size(((const struct record_header *)record)->len);
+        }
+        else if (latest[key]) {
+            pos += record_size(((const struct record_header *)record_at(latest[key]))->len);
+        }
+    }
+    if (pos > FLASH_KV_PAGE_SIZE) {
+        return -ENOSPC;
+    }
+
+    int retval = erase_if_needed(target);
+    if (retval != 0) {
+        return retval;
+    }
+
+    pos = BLOCK_SIZE;
+    for (unsigned key = 0; key < CONFIG_FLASH_KV_KEYS; key++) {
+        const uint8_t *src = (key == new_key) ? record
+                                              : (latest[key] ? record_at(latest[key]) : NULL);
+        if (!src) {
+            continue;
+        }
+
+        /* copy via RAM, the source needs to be word aligned and must not be
+         * read from flash while programming */
+        uint32_t buf[RECORD_MAX / sizeof(uint32_t)];
+        size_t size = record_size(((const struct record_header *)src)->len);
+        memcpy(buf, src, size);
+        retval = flash_kv_backend_write(target, pos, buf, size);
+        if (retval != 0) {
+            return retval;
+        }
+        new_latest[key] = pos;
+        pos += size;
+    }
+
+    /* only now the target page becomes valid */
+    retval = write_header(target, seq + 1);
+    if (retval != 0) {
+        return retval;
+    }
+
+    active = target;
+    seq++;
+    memcpy(latest, new_latest, sizeof(latest));
+    write_pos = pos;
+
+    return 0;
+}
+
+ssize_t flash_kv_get(unsigned key, void *dest, size_t size)
+{
+    if (mount() != 0) {
+        return -EIO;
+    }
+
+    if ((key >= CONFIG_FLASH_KV_KEYS) || !latest[key]) {
+        return -ENOENT;
+    }
+
+    const uint8_t *record = record_at(latest[key]);
+    const struct record_header *hdr = (const void *)record;
+    memcpy(dest, record_value(record), (size < hdr->len) ? size : hdr->len);
+    return hdr->len;
+}
+
+uint32_t flash_kv_get_u32(unsigned key, uint32_t fallback)
+{
+    uint32_t value;
+    if (flash_kv_get(key, &value, sizeof(value)) != sizeof(value)) {
+        return fallback;
+    }
+
+    return value;
+}
+
+int flash_kv_set(unsigned key, const void *value, size_t len)
+{
+    if ((key >= CONFIG_FLASH_KV_KEYS) || (len > CONFIG_FLASH_KV_VALUE_MAX)) {
+        return -EINVAL;
+    }
+
+    int retval = mount();
+    if (retval != 0) {
+        return retval;
+    }
+
+    if (latest[key]) {
+        const uint8_t *record = record_at(latest[key]);
+        const struct record_header *hdr = (const void *)record;
+        if ((hdr->len == len) && !memcmp(record_value(record), value, len)) {
+            /* spare the flash */
+            return 0;
+        }
+    }
+
+    uint32_t buf[RECORD_MAX / sizeof(uint32_t)];
+    uint8_t *record = (uint8_t *)buf;
+    struct record_header *hdr = (void *)record;
+    size_t size = record_size(len);
+
+    memset(buf, 0xff, size);
+    hdr->key = key;
+    hdr->len = len;
+    memcpy(record + offsetof(struct record_header, value), value, len);
+    hdr->crc = record_crc(record);
+
+    if (write_pos + size > FLASH_KV_PAGE_SIZE) {
+        retval = compact(record);
+    }
+    else {
+        retval = flash_kv_backend_write(active, write_pos, buf, size);
+        if (retval == 0) {
+            latest[key] = write_pos;
+            write_pos += size;
+        }
+    }
+
+    if (retval == -EIO) {
+        /* the state in flash is unknown now, mount again */
+        mounted = false;
+    }
+
+    return retval;
+}
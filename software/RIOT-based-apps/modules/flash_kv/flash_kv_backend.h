@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_flash_kv
+ * @{
+ *
+ * @file
+ * @brief       Flash access of the key/value store, either real or simulated
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef FLASH_KV_BACKEND_H
+#define FLASH_KV_BACKEND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if MODULE_FLASH_KV_SIM
+#  include "flash_kv_sim.h"
+#else
+#  include "periph/flashpage.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of a page of the store in bytes
+ */
+#if MODULE_FLASH_KV_SIM
+#  define FLASH_KV_PAGE_SIZE    CONFIG_FLASH_KV_SIM_PAGE_SIZE
+#else
+#  define FLASH_KV_PAGE_SIZE    FLASHPAGE_SIZE
+#endif
+
+/**
+ * @brief   Get the contents of the given page of the store
+ *
+ * @param[in]   page    Page of the store (0 or 1)
+ */
+const uint8_t *flash_kv_backend_page(unsigned page);
+
+/**
+ * @brief   Erase the given page of the store
+ *
+ * @param[in]   page    Page of the store (0 or 1)
+ *
+ * @retval  0       Success
+ * @retval  -EIO    Erasing failed
+ */
+int flash_kv_backend_erase(unsigned page);
+
+/**
+ * @brief   Program data into erased flash
+ *
+ * @param[in]   page    Page of the store (0 or 1)
+ * @param[in]   offset  Offset in the page, aligned to 8 bytes
+ * @param[in]   data    Data to write, aligned to 4 bytes
+ * @param[in]   len     Length of @p data, a multiple of 8 bytes
+ *
+ * @retval  0       Success
+ * @retval  -EIO    Writing failed
+ */
+int flash_kv_backend_write(unsigned page, size_t offset, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLASH_KV_BACKEND_H */
+/** @} */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_flash_kv
+ * @{
+ *
+ * @file
+ * @brief       Key/value store backend using the internal flash
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "flash_kv_backend.h"
+#include "periph/flashpage.h"
+
+/* The pages are taken from the auxiliary slot, which the linker keeps the
+ * firmware out of: A firmware too large to leave room for the store fails
+ * to link rather than being overwritten. See SLOT_AUX_LEN in the board */
+#ifndef CONFIG_SLOT_AUX_LEN
+#  error "flash_kv needs flash reserved via SLOT_AUX_LEN"
+#endif
+
+#ifndef CONFIG_FLASH_KV_FIRST_PAGE
+#  define CONFIG_FLASH_KV_FIRST_PAGE    (CONFIG_SLOT_AUX_OFFSET / FLASHPAGE_SIZE)
+#endif
+
+static_assert(CONFIG_FLASH_KV_FIRST_PAGE * FLASHPAGE_SIZE >= CONFIG_SLOT_AUX_OFFSET,
+              "the store must not start before the auxiliary slot");
+static_assert((CONFIG_FLASH_KV_FIRST_PAGE + 2) * FLASHPAGE_SIZE
+              <= CONFIG_SLOT_AUX_OFFSET + CONFIG_SLOT_AUX_LEN,
+              "the auxiliary slot must hold both pages of the store");
+static_assert(8 % FLASHPAGE_WRITE_BLOCK_SIZE == 0,
+              "records need to be programmable in blocks of 8 bytes");
+
+const uint8_t *flash_kv_backend_page(unsigned page)
+{
+    return flashpage_addr(CONFIG_FLASH_KV_FIRST_PAGE + page);
+}
+
+/* The flashpage API does not report errors, so verify the result instead */
+int flash_kv_backend_erase(unsigned page)
+{
+    flashpage_erase(CONFIG_FLASH_KV_FIRST_PAGE + page);
+
+    const uint8_t *data = flash_kv_backend_page(page);
+    for (size_t i = 0; i < FLASHPAGE_SIZE; i++) {
+        if (data[i] != 0xff) {
+            return -EIO;
+        }
+    }
+
+    return 0;
+}
+
+int flash_kv_backend_write(unsigned page, size_t offset, const void *data, size_t len)
+{
+    uint8_t *target = (uint8_t *)flash_kv_backend_page(page) + offset;
+    flashpage_write(target, data, len);
+
+    return memcmp(target, data, len) ? -EIO : 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_flash_kv_sim
+ * @{
+ *
+ * @file
+ * @brief       Simulated flash with power loss injection
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "flash_kv_backend.h"
+#include "flash_kv_sim.h"
+
+#define BLOCK_SIZE  8U
+
+static uint8_t flash[2][CONFIG_FLASH_KV_SIM_PAGE_SIZE] = {
+    [0 ... 1] = { [0 ... CONFIG_FLASH_KV_SIM_PAGE_SIZE - 1] = 0xff },
+};
+static uint32_t erases[2];
+static uint32_t ops;
+static uint32_t cut_at = FLASH_KV_SIM_NO_CUT;
+static bool power_lost;
+
+/* returns true if the current operation is to be cut short */
+static bool next_op(void)
+{
+    ops++;
+    if (cut_at == 0) {
+        cut_at = FLASH_KV_SIM_NO_CUT;
+        power_lost = true;
+        return true;
+    }
+
+    if (cut_at != FLASH_KV_SIM_NO_CUT) {
+        cut_at--;
+    }
+    return false;
+}
+
+void flash_kv_sim_cut_at(uint32_t op)
+{
+    cut_at = op;
+}
+
+void flash_kv_sim_power_on(void)
+{
+    cut_at = FLASH_KV_SIM_NO_CUT;
+    power_lost = false;
+}
+
+bool flash_kv_sim_power_lost(void)
+{
+    return power_lost;
+}
+
+uint32_t flash_kv_sim_ops(void)
+{
+    return ops;
+}
+
+uint32_t flash_kv_sim_erases(unsigned page)
+{
+    assert(page < 2);
+    return erases[page];
+}
+
+void flash_kv_sim_reset(void)
+{
+    memset(flash, 0xff, sizeof(flash));
+    memset(erases, 0, sizeof(erases));
+    ops = 0;
+    flash_kv_sim_power_on();
+}
+
+const uint8_t *flash_kv_backend_page(unsigned page)
+{
+    assert(page < 2);
+    return flash[page];
+}
+
+int flash_kv_backend_erase(unsigned page)
+{
+    assert(page < 2);
+    if (power_lost) {
+        return -EIO;
+    }
+
+    erases[page]++;
+    if (next_op()) {
+        memset(flash[page], 0xff, sizeof(flash[page]) / 2);
+        return -EIO;
+    }
+
+    memset(flash[page], 0xff, sizeof(flash[page]));
+    return 0;
+}
+
+int flash_kv_backend_write(unsigned page, size_t offset, const void *data, size_t len)
+{
+    assert(page < 2);
+    assert((offset % BLOCK_SIZE == 0) && (len % BLOCK_SIZE == 0));
+    assert(offset + len <= CONFIG_FLASH_KV_SIM_PAGE_SIZE);
+    if (power_lost) {
+        return -EIO;
+    }
+
+    uint8_t *dest = &flash[page][offset];
+    const uint8_t *src = data;
+    for (size_t i = 0; i < len; i++) {
+        /* programming non-erased flash fails on the STM32G0 */
+        assert(dest[i] == 0xff);
+    }
+
+    if (next_op()) {
+        /* program the first half of the blocks and tear the next one by
+         * programming only some of its bits */
+        size_t done = (len / BLOCK_SIZE / 2) * BLOCK_SIZE;
+        memcpy(dest, src, done);
+        for (size_t i = done; i < done + BLOCK_SIZE; i++) {
+            dest[i] = src[i] | 0x5a;
+        }
+        return -EIO;
+    }
+
+    memcpy(dest, src, len);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_flash_kv  Log-Structured Key/Value Store in Flash
+ * @ingroup     sys
+ *
+ * Module `flash_kv` keeps small values such as high scores and settings
+ * across power cycles in two pages of the internal flash. The board reserves
+ * them as auxiliary slot (`SLOT_AUX_LEN`), which keeps the firmware out of
+ * them at link time.
+ *
+ * The store is a log: Setting a value appends a record to the active page,
+ * older records of the same key are left in place. Only when the active page
+ * is full, the latest record of every key is copied to the other page
+ * (compaction), which then becomes the active page. This way a page is
+ * erased once per compaction only, and setting a value of up to four bytes
+ * programs a single double word.
+ *
+ * The only RAM used is an index with the position of the latest record of
+ * every key (@ref CONFIG_FLASH_KV_KEYS).
+ *
+ * Layout (in blocks of 8 bytes, the flash programming unit of the STM32G0):
+ *
+ * - Every page starts with a header block: a magic number and a 16 bit
+ *   sequence number, stored a second time inverted. The page with the
+ *   newer valid header is the active page.
+ * - Every record starts with a block holding the key, the length of the
+ *   value, a CRC-16 over key, length and value, and the first four bytes of
+ *   the value. The remaining bytes follow in as many blocks as needed.
+ * - The log ends at the first erased block.
+ *
+ * Recovery after a power loss at any point:
+ *
+ * - A record cut short fails the CRC and is skipped, so the previous value
+ *   of the key stays in effect
+ * - A compaction cut short leaves the other page without a valid header,
+ *   so it is ignored and erased again by the next compaction. The header is
+ *   written last.
+ * - If anything but erased flash follows the end of the log, the rest of
+ *   the page is not used and the next write compacts
+ *
+ * With module `flash_kv_sim` the store operates on a simulated flash region
+ * in RAM instead, in which power losses can be injected at any flash
+ * operation, see @ref sys_flash_kv_sim.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `flash_kv` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef FLASH_KV_H
+#define FLASH_KV_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of keys, i.e. the size of the index in RAM
+ */
+#ifndef CONFIG_FLASH_KV_KEYS
+#  define CONFIG_FLASH_KV_KEYS          8
+#endif
+
+/**
+ * @brief   Largest value in bytes (at most 255)
+ */
+#ifndef CONFIG_FLASH_KV_VALUE_MAX
+#  define CONFIG_FLASH_KV_VALUE_MAX     32
+#endif
+
+/**
+ * @brief   Keys in use in this repository
+ *
+ * All keys live in the same store, so they are allocated here to avoid
+ * collisions.
+ */
+typedef enum {
+    FLASH_KV_KEY_FLAPPY_LED_HIGHSCORE,          /**< High score of Flappy LED */
+    FLASH_KV_KEY_LEDMON_SAYS_HIGHSCORE,         /**< High score of LEDmon says */
+    FLASH_KV_KEY_BUTTON_MATRIX_SETTLE_READS,    /**< Calibrated settle time of the buttons */
+    FLASH_KV_KEY_TEST,                          /**< First key free for tests */
+} flash_kv_key_t;
+
+/**
+ * @brief   Mount the store, recovering from an interrupted write if needed
+ *
+ * If neither page holds a valid store, an empty store is created.
+ *
+ * @retval  0       Success
+ * @retval  -EIO    Writing to flash failed
+ *
+ * @note    The other functions mount the store on first use, calling this
+ *          is only needed to mount it again (e.g. after a simulated power
+ *          loss).
+ */
+int flash_kv_init(void);
+
+/**
+ * @brief   Get the value of the given key
+ *
+ * @param[in]   key     The key to get the value of
+ * @param[out]  dest    Buffer to write the value to
+ * @param[in]   size    Size of @p dest in bytes
+ *
+ * @return  The length of the value, which may be larger than @p size (the
+ *          value is truncated then)
+ * @retval  -ENOENT     No value stored for @p key
+ * @retval  -EIO        Mounting the store failed
+ */
+ssize_t flash_kv_get(unsigned key, void *dest, size_t size);
+
+/**
+ * @brief   Set the value of the given key
+ *
+ * @param[in]   key     The key to set the value of
+ * @param[in]   value   The new value
+ * @param[in]   len     Length of @p value in bytes
+ *
+ * Nothing is written if the value stored already is the same. If power is
+ * lost before this returns, either the new or the previous value is stored.
+ *
+ * @retval  0           Success
+ * @retval  -EINVAL     @p key or @p len out of range
+ * @retval  -ENOSPC     The latest values of all keys do not fit in a page
+ * @retval  -EIO        Writing to flash failed
+ */
+int flash_kv_set(unsigned key, const void *value, size_t len);
+
+/**
+ * @brief   Get a value of type `uint32_t`, or the given default
+ */
+uint32_t flash_kv_get_u32(unsigned key, uint32_t fallback);
+
+/**
+ * @brief   Set a value of type `uint32_t`
+ */
+static inline int flash_kv_set_u32(unsigned key, uint32_t value)
+{
+    return flash_kv_set(key, &value, sizeof(value));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLASH_KV_H */
+/** @} */
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_flash_kv_sim  Simulated Flash for the Key/Value Store
+ * @ingroup     sys_flash_kv
+ *
+ * With module `flash_kv_sim` the key/value store operates on two pages of
+ * simulated flash in RAM, so that the layout and the recovery logic can be
+ * tested on any board (e.g. `native`).
+ *
+ * The simulation enforces the rules of the STM32G0 flash: Only erased
+ * double words aligned to their size can be programmed.
+ *
+ * A power loss can be injected at any flash operation with
+ * @ref flash_kv_sim_cut_at. The operation hit by the power loss is done only
+ * partially: A write only programs the first blocks of its data and leaves
+ * the block being programmed torn, an erase only erases the first half of
+ * the page. All following operations fail until @ref flash_kv_sim_power_on
+ * is called, which corresponds to rebooting the device (and mounting the
+ * store again with @ref flash_kv_init).
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `flash_kv_sim` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef FLASH_KV_SIM_H
+#define FLASH_KV_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of a simulated flash page in bytes
+ */
+#ifndef CONFIG_FLASH_KV_SIM_PAGE_SIZE
+#  define CONFIG_FLASH_KV_SIM_PAGE_SIZE     2048
+#endif
+
+/**
+ * @brief   Value of @ref flash_kv_sim_cut_at to never lose power
+ */
+#define FLASH_KV_SIM_NO_CUT                 UINT32_MAX
+
+/**
+ * @brief   Lose power during the given flash operation
+ *
+ * @param[in]   op      Number of the operation to cut short, counting from
+ *                      the current one (0), or @ref FLASH_KV_SIM_NO_CUT
+ */
+void flash_kv_sim_cut_at(uint32_t op);
+
+/**
+ * @brief   Restore power after a power loss
+ */
+void flash_kv_sim_power_on(void);
+
+/**
+ * @brief   Check if power has been lost
+ */
+bool flash_kv_sim_power_lost(void);
+
+/**
+ * @brief   Get the number of flash operations (erases and writes) so far
+ */
+uint32_t flash_kv_sim_ops(void);
+
+/**
+ * @brief   Get the number of times the given page has been erased
+ *
+ * @param[in]   page    Page of the store (0 or 1)
+ */
+uint32_t flash_kv_sim_erases(unsigned page);
+
+/**
+ * @brief   Erase the simulated flash and reset all counters
+ */
+void flash_kv_sim_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLASH_KV_SIM_H */
+/** @} */
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+"""
+Encode an animation for the LED matrix into C code using the format described
+in led_matrix.h. The input is either a sequence of PBM/PGM images (one per
+frame) or, if Pillow is installed, a GIF or a sequence of other images.
+
+Every frame is stored in the smallest of the three encodings: run length
+encoded on a blank frame (key), run length encoded changes to the previous
+frame (delta), or uncompressed (raw). Consecutive identical frames are merged
+into one frame with the combined duration.
+"""
+
+from argparse import ArgumentParser
+from os.path import basename
+from sys import exit
+
+FRAME_KEY = 0
+FRAME_DELTA = 1
+FRAME_RAW = 2
+TYPE_SHIFT = 14
+DURATION_MAX = 0x3fff
+OP_RUN = 0x80
+SKIP_MAX = 128
+RUN_MAX = 8
+BRIGHTNESS_MAX = 15
+
+
+def read_netpbm(path):
+    """Read a PBM (P1, P4) or PGM (P2, P5) file, return rows of brightness values"""
+    with open(path, "rb") as f:
+        content = f.read()
+
+    magic = content[:2]
+    if magic not in (b"P1", b"P2", b"P4", b"P5"):
+        return None
+
+    numof_tokens = 2 if magic in (b"P1", b"P4") else 3
+    tokens = []
+    pos = 2
+    # parse the header (width, height, maxval), skipping comments
+    while len(tokens) < numof_tokens:
+        while content[pos:pos + 1].isspace():
+            pos += 1
+        if content[pos:pos + 1] == b"#":
+            pos = content.index(b"\n", pos)
+            continue
+        start = pos
+        while not content[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(int(content[start:pos]))
+    width, height = tokens[:2]
+    pos += 1
+
+    if magic == b"P1":
+        # set pixels are black on paper, but lit on the LED matrix
+        bits = [int(c) for c in content[pos:].decode("ascii") if c in "01"]
+        values = [b * BRIGHTNESS_MAX for b in bits]
+    elif magic == b"P4":
+        stride = (width + 7) // 8
+        values = []
+        for y in range(height):
+            row = content[pos + y * stride:pos + (y + 1) * stride]
+            values += [((row[x >> 3] >> (7 - (x & 0x7))) & 1) * BRIGHTNESS_MAX
+                       for x in range(width)]
+    else:
+        maxval = tokens[2]
+        if magic == b"P2":
+            samples = [int(t) for t in content[pos:].split()]
+        else:
+            samples = list(content[pos:pos + width * height])
+        values = [(s * BRIGHTNESS_MAX + maxval // 2) // maxval for s in samples]
+
+    return [values[y * width:(y + 1) * width] for y in range(height)]
+
+
+def pillow_frames(path):
+    """Yield (rows, duration in ms or None) for every frame in the image"""
+    try:
+        from PIL import Image, ImageSequence
+    except ImportError:
+        exit(f"{path}: Pillow is needed to read images other than PBM/PGM")
+
+    with Image.open(path) as img:
+        for frame in ImageSequence.Iterator(img):
+            gray = frame.convert("L")
+            rows = [[(gray.getpixel((x, y)) * BRIGHTNESS_MAX + 127) // 255
+                     for x in range(gray.width)] for y in range(gray.height)]
+            yield rows, frame.info.get("duration")
+
+
+def load_frames(paths, frame_ms):
+    frames = []
+    for path in paths:
+        rows = read_netpbm(path)
+        if rows is not None:
+            frames.append((rows, frame_ms))
+            continue
+        for rows, duration in pillow_frames(path):
+            frames.append((rows, duration or frame_ms))
+    return frames
+
+
+def to_pixels(rows, width, height, path):
+    """Flatten the rows into frame buffer order (column by column)"""
+    if (len(rows) != height) or any(len(row) != width for row in rows):
+        exit(f"{path}: expected frames of {width}x{height} pixels")
+    return [rows[y][x] for x in range(width) for y in range(height)]
+
+
+def encode_ops(pixels, base):
+    ops = []
+    pos = 0
+    while pos < len(pixels):
+        run = 1
+        if pixels[pos] == base[pos]:
+            while (pos + run < len(pixels)) and (pixels[pos + run] == base[pos + run]) \
+                    and (run < SKIP_MAX):
+                run += 1
+            ops.append(run - 1)
+        else:
+            while (pos + run < len(pixels)) and (pixels[pos + run] == pixels[pos]) \
+                    and (run < RUN_MAX):
+                run += 1
+            ops.append(OP_RUN | ((run - 1) << 4) | pixels[pos])
+        pos += run
+    return ops
+
+
+def encode_raw(pixels):
+    # two pixels per byte, the first one in the low nibble
+    padded = pixels + [0] * (len(pixels) & 1)
+    return [padded[i] | (padded[i + 1] << 4) for i in range(0, len(padded), 2)]
+
+
+def encode(frames):
+    """Encode a list of (pixels, duration) into the byte stream"""
+    data = []
+    prev = None
+    for pixels, duration in frames:
+        candidates = [(FRAME_RAW, encode_raw(pixels)),
+                      (FRAME_KEY, encode_ops(pixels, [0] * len(pixels)))]
+        if prev is not None:
+            candidates.append((FRAME_DELTA, encode_ops(pixels, prev)))
+        # on ties prefer raw (memcpy) over key over delta frames
+        kind, payload = min(candidates, key=lambda c: len(c[1]))
+        header = (kind << TYPE_SHIFT) | duration
+        data += [header & 0xff, header >> 8] + payload
+        prev = pixels
+    return data
+
+
+def merge_repeated(frames):
+    result = []
+    for pixels, duration in frames:
+        if result and (result[-1][0] == pixels) and (result[-1][1] + duration <= DURATION_MAX):
+            result[-1] = (pixels, result[-1][1] + duration)
+        else:
+            result.append((pixels, duration))
+    return result
+
+
+def print_array(name, values, per_line=8):
+    print(f"static const uint8_t {name}[] = {{")
+    for i in range(0, len(values), per_line):
+        line = " ".join(f"{v:#04x}," for v in values[i:i + per_line])
+        print(f"    {line}")
+    print("};\n")
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description="Encode an animation for the LED matrix as C code")
+    parser.add_argument("inputs", metavar="IMAGE", nargs="+",
+                        help="GIF file or images of the individual frames")
+    parser.add_argument("--name", required=True,
+                        help="name of the C variable holding the animation")
+    parser.add_argument("--width", type=int, default=10, help="width of the LED matrix")
+    parser.add_argument("--height", type=int, default=9, help="height of the LED matrix")
+    parser.add_argument("--fps", type=int, default=60, help="frame rate of the LED matrix")
+    parser.add_argument("--frame-ms", type=int, default=100,
+                        help="duration of frames without timing information in ms")
+    args = parser.parse_args()
+
+    frames = []
+    for rows, ms in load_frames(args.inputs, args.frame_ms):
+        pixels = to_pixels(rows, args.width, args.height, args.inputs[0])
+        duration = max(1, round(ms * args.fps / 1000))
+        if duration > DURATION_MAX:
+            exit(f"frame duration of {ms} ms too long")
+        frames.append((pixels, duration))
+
+    frames = merge_repeated(frames)
+    data = encode(frames)
+    raw_size = len(frames) * (2 + len(encode_raw(frames[0][0])))
+
+    print(f"/* This file is auto generated using {basename(parser.prog)} */")
+    print("#include <stdint.h>")
+    print("#include \"led_matrix.h\"")
+    print("")
+    print_array(f"_{args.name}", data)
+    print(f"const led_matrix_anim_t {args.name} = " + "{")
+    print(f"    .data = _{args.name},")
+    print(f"    .frames_numof = {len(frames)},")
+    print("};\n")
+    print(f"/* animation data: {len(data)} bytes, uncompressed: {raw_size} bytes */")
@@ -53,6 +53,19 @@
  * The LED matrix is updated using a periodic timer IRQ. Double buffering is
  * used to allow rendering to a scratch framebuffer without visual glitches.
  *
+ * With module `led_matrix_virtual` (selected automatically on the `native`
+ * board) no GPIOs are driven. The timer IRQ then fires once per frame only,
+ * which keeps frame numbers, frame switches and scanning the buttons in the
+ * refresh ISR working the same way as on the hardware.
+ *
+ * With module `led_matrix_headless` (on top of `led_matrix_virtual`) there
+ * is no timer at all: Waiting for a frame (@ref led_matrix_fb_switch,
+ * @ref led_matrix_wait_for_frame) advances the frame counter right away
+ * instead, doing all the work of the refresh ISR in between. A hash of each
+ * frame shown is emitted via stdio (see
+ * @ref CONFIG_LED_MATRIX_HEADLESS_PRINT_FRAMES), so that runs can be
+ * checked for identical output a lot faster than real time.
+ *
  * @{
  *
  * @file
@@ -64,6 +77,7 @@
 #ifndef LED_MATRIX_H
 #define LED_MATRIX_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "bitmap_fonts.h"
@@ -91,6 +105,38 @@ extern "C" {
  */
 #define LED_MATRIX_BRIGHTNESS_MAX       (LED_MATRIX_BRIGHTNESS_LEVELS - 1U)
 
+/**
+ * @brief   The number of frames shown per second
+ */
+#define LED_MATRIX_FPS                  60U
+
+/**
+ * @brief   Print the frame number and the hash of every frame shown with
+ *          module `led_matrix_headless`
+ *
+ * Set to 0 if only @ref led_matrix_headless_hash is of interest.
+ */
+#ifndef CONFIG_LED_MATRIX_HEADLESS_PRINT_FRAMES
+#  define CONFIG_LED_MATRIX_HEADLESS_PRINT_FRAMES   1
+#endif
+
+/**
+ * @brief   How the refresh ISR multiplexes the LEDs
+ */
+typedef enum {
+    /**
+     * @brief   Every LED gets one time slot per brightness level, so that
+     *          all brightness levels are shown (default)
+     */
+    LED_MATRIX_REFRESH_GRAYSCALE,
+    /**
+     * @brief   Every LED gets a single time slot as long as
+     *          @ref LED_MATRIX_BRIGHTNESS_MAX slots of the grayscale mode,
+     *          every LED not off is shown at full brightness
+     */
+    LED_MATRIX_REFRESH_MONO,
+} led_matrix_refresh_t;
+
 
 /**
  * @brief   Set the brightness of the given LED matrix in the scratch
@@ -111,6 +157,25 @@ extern "C" {
  */
 void led_matrix_fb_set(int x, int y, uint8_t brightness);
 
+/**
+ * @brief   Overwrite a whole column of the scratch frame buffer
+ *
+ * @param   x           X-coordinate of the column
+ * @param   mask        Pixels to turn on, bit 0 is the topmost pixel
+ * @param   brightness  Brightness of the pixels turned on
+ *
+ * Pixels not in @p mask are turned off. This is a lot faster than setting
+ * the pixels one by one with @ref led_matrix_fb_set.
+ *
+ * @note    Calling this function with an out of range value for @p x is
+ *          safe and will leave the scratch frame buffer unmodified.
+ *
+ * @warning This function is not thread-safe. The caller must ensure
+ *          that no other thread is concurrently accessing the
+ *          LED matrix's frame buffers.
+ */
+void led_matrix_fb_column(int x, unsigned mask, uint8_t brightness);
+
 /**
  * @brief   Clear all pixels in the scratch buffer
  *
@@ -120,6 +185,35 @@ void led_matrix_fb_set(int x, int y, uint8_t brightness);
  */
 void led_matrix_fb_clear(void);
 
+/**
+ * @brief   Copy the frame currently shown into the scratch buffer
+ *
+ * This allows updating the frame shown incrementally, instead of drawing
+ * every frame from scratch.
+ *
+ * @warning This function is not thread-safe. The caller must ensure
+ *          that no other thread is concurrently accessing the
+ *          LED matrix's frame buffers.
+ */
+void led_matrix_fb_copy_active(void);
+
+/**
+ * @brief   Get the scratch frame buffer for rendering into it directly
+ *
+ * @return  The scratch frame buffer
+ *
+ * The pixels are stored column by column, from top to bottom, with
+ * @ref LED_MATRIX_BRIGHTNESS_BITS bits per pixel: Pixel `(x, y)` is the
+ * `x * LED_MATRIX_HEIGHT + y`-th one, every byte holds two pixels with the
+ * lower nibble being the first. Full screen effects can fill the buffer in
+ * this order without the bounds checks and read-modify-write cycles of
+ * @ref led_matrix_fb_set.
+ *
+ * @warning The buffer is swapped with the one shown by
+ *          @ref led_matrix_fb_switch, call this again after every switch.
+ */
+uint8_t *led_matrix_fb_scratch(void);
+
 /**
  * @brief   Switch the active buffer with the scratch buffer at
  *          just before drawing the given frame number
@@ -127,12 +221,18 @@ void led_matrix_fb_clear(void);
  * @param[in]   at_frame_number     The number of the frame to switch at
  *
  * This function will block the caller until the frame buffer has been
- * switched. The switch is done in the drawing ISR right between
- * `at_frame_number - 1` and `at_frame_number`, if that point in
- * time is still in the future. Otherwise the framebuffer is switched
- * at the next frame
+ * switched. The switch is done in the drawing ISR right after frame
+ * `at_frame_number` has been shown, if that point in time is still in the
+ * future. Otherwise the framebuffer is switched at the end of the current
+ * frame.
  *
- * @return  The frame that the frame buffer was switched at
+ * So the new content is shown from frame `at_frame_number + 1` on (at the
+ * earliest), and that is the frame number returned. A loop doing
+ * `frame = led_matrix_fb_switch(frame) + n` shows every frame for `n + 1`
+ * frames.
+ *
+ * @return  The frame that the frame buffer was switched at, i.e. the first
+ *          frame showing the new content
  *
  * @warning This function is not thread-safe. The caller must ensure
  *          that no other thread is concurrently accessing the
@@ -140,6 +240,40 @@ void led_matrix_fb_clear(void);
  */
 uint32_t led_matrix_fb_switch(uint32_t at_frame_number);
 
+/**
+ * @brief   Request switching the frame buffers like @ref led_matrix_fb_switch
+ *          does, but without waiting for the switch
+ *
+ * @param[in]   at_frame_number     The number of the frame to switch at
+ *
+ * Use @ref led_matrix_fb_switch_done to check when the switch happened.
+ * The scratch buffer holds the frame to show until then, so it must not be
+ * drawn into before the switch completed.
+ *
+ * @warning This function is not thread-safe. The caller must ensure
+ *          that no other thread is concurrently accessing the
+ *          LED matrix's frame buffers.
+ */
+void led_matrix_fb_switch_request(uint32_t at_frame_number);
+
+/**
+ * @brief   Check if the switch requested with
+ *          @ref led_matrix_fb_switch_request has happened
+ *
+ * @param[out]  frame_number    The frame that the frame buffer was switched
+ *                              at, only written if the switch happened. May
+ *                              be `NULL`.
+ *
+ * @retval  true    The frame buffers have been switched (or no switch was
+ *                  requested)
+ * @retval  false   The switch is still pending
+ *
+ * @note    With module `led_matrix_headless` time only advances when
+ *          waiting, so this needs to be polled between calls to
+ *          @ref led_matrix_wait_for_frame.
+ */
+bool led_matrix_fb_switch_done(uint32_t *frame_number);
+
 /**
  * @brief   Prepares the LED matrix and configures and enabled the
  *          periodic timer ISR to draw the matrix
@@ -150,6 +284,22 @@ uint32_t led_matrix_fb_switch(uint32_t at_frame_number);
  */
 int led_matrix_init(void);
 
+/**
+ * @brief   Select how the refresh ISR multiplexes the LEDs
+ *
+ * @param[in]   mode    The refresh mode to use from the next frame on
+ *
+ * The frame rate is the same in both modes, as are LEDs at full
+ * brightness. But in mono mode the refresh ISR runs only
+ * @ref LED_MATRIX_LED_NUMOF instead of @ref LED_MATRIX_SLOTS_PER_FRAME times
+ * per frame, which is the cheapest way to keep a static image lit. This
+ * only makes a difference on the hardware, the virtual LED matrix runs the
+ * refresh ISR once per frame anyway.
+ *
+ * This function is thread-safe.
+ */
+void led_matrix_set_refresh(led_matrix_refresh_t mode);
+
 /**
  * @brief   Delay execution of the calling thread until (at least) the
  *          frame number given has been fully rendered.
@@ -179,6 +329,10 @@ uint32_t led_matrix_frame_number(void);
 
 /**
  * @brief   Render the given glyph into the scratch frame buffer
+ *
+ * Specialized renderers are compiled in for glyphs of 8 and 5 pixel height,
+ * other heights use a slower generic renderer.
+ *
  * @param[in]   glyph   The glyph to place
  * @param[in]   x       X coordinate to place the topmost corner of the glyph
  * @param[in]   y       Y coordinate to place the leftmost corner of the glyph
@@ -227,6 +381,40 @@ void led_matrix_text(const bitmap_font_t *font, const char *text, size_t len,
 void led_matrix_text_scroll(const bitmap_font_t *font, const char *text, size_t len,
                             uint8_t brightness);
 
+/**
+ * @brief   Callback deciding how long to show the next column of a scroll
+ *          animation
+ *
+ * @param[in]   arg         The argument passed along with the callback
+ *
+ * @return  Number of frames to show the next column for
+ * @retval  0   Stop the animation right away
+ */
+typedef unsigned (*led_matrix_scroll_speed_t)(void *arg);
+
+/**
+ * @brief   Similar to @ref led_matrix_text_scroll, but with the scroll speed
+ *          decided column by column
+ *
+ * @param[in]   font        The bitmap font to use
+ * @param[in]   text        The text to render
+ * @param[in]   len         Length of @p text in bytes
+ * @param[in]   brightness  The brightness of the text
+ * @param[in]   speed       Called before every column to get the number of
+ *                          frames to show it for
+ * @param[in]   arg         Argument to pass to @p speed
+ *
+ * @warning This function is not thread-safe. The caller must ensure
+ *          that no other thread is concurrently accessing the
+ *          LED matrix's frame buffers.
+ *
+ * This function returns once the full text has scrolled through the
+ * LED matrix or @p speed returned 0, and the screen is blank again.
+ */
+void led_matrix_text_scroll_adaptive(const bitmap_font_t *font, const char *text,
+                                     size_t len, uint8_t brightness,
+                                     led_matrix_scroll_speed_t speed, void *arg);
+
 /**
  * @brief   Similar to @ref led_matrix_text_scroll but loops through the
  *          text until at least one of the given set of buttons is pressed
@@ -242,6 +430,9 @@ void led_matrix_text_scroll(const bitmap_font_t *font, const char *text, size_t
  * @pre     @p btn_len equals `(BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8)` (or is exactly
  *          the size needed to hold all buttons present in the board)
  *
+ * With module `button_matrix_events` only buttons pressed while the text
+ * is scrolling end the loop, and the corresponding events are consumed.
+ *
  * @warning This function is only provided if module `button_matrix` is also used.
  */
 void led_matrix_text_scroll_until_button(const bitmap_font_t *font,
@@ -250,6 +441,153 @@ void led_matrix_text_scroll_until_button(const bitmap_font_t *font,
                                          uint8_t *btn_target,
                                          size_t btn_len,
                                          uint8_t brightness);
+
+/**
+ * @brief   Show an animation that scrolls the given pre-rendered image
+ *          (e.g. text rendered at build time) through the LED matrix
+ *
+ * @param[in]   image       The image to scroll through
+ * @param[in]   brightness  The brightness of the image
+ *
+ * Unlike @ref led_matrix_text_scroll no glyph lookups and spacing computations
+ * are needed. Use `bitmap_fonts/dist/assets2c.py` to render constant text
+ * at build time.
+ *
+ * @warning This function is not thread-safe. The caller must ensure
+ *          that no other thread is concurrently accessing the
+ *          LED matrix's frame buffers.
+ *
+ * This function returns once the full image has scrolled through the
+ * LED matrix and the screen is blank again.
+ */
+void led_matrix_image_scroll(const bitmap_glyph_t *image, uint8_t brightness);
+
+/**
+ * @brief   Similar to @ref led_matrix_image_scroll but loops through the
+ *          image until at least one of the given set of buttons is pressed
+ *
+ * @param[in]   image       The image to scroll through
+ * @param[in]   btn_filter  Bitmask specifying the buttons used to exit the message
+ * @param[out]  btn_target  Bitmask of the buttons actually pressed
+ * @param[in]   btn_len     Size of @p btn_filter and @p btn_target
+ * @param[in]   brightness  The brightness of the image
+ *
+ * @pre     @p btn_len equals `(BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8)` (or is exactly
+ *          the size needed to hold all buttons present in the board)
+ *
+ * @warning This function is only provided if module `button_matrix` is also used.
+ */
+void led_matrix_image_scroll_until_button(const bitmap_glyph_t *image,
+                                          const uint8_t *btn_filter,
+                                          uint8_t *btn_target,
+                                          size_t btn_len,
+                                          uint8_t brightness);
+
+/**
+ * @brief   Get a hash over all frames shown so far and the frame numbers
+ *          they were switched to at
+ *
+ * @note    Only available with module `led_matrix_headless`
+ */
+uint32_t led_matrix_headless_hash(void);
+
+/**
+ * @brief   Restart the hash returned by @ref led_matrix_headless_hash
+ *
+ * @note    Only available with module `led_matrix_headless`
+ */
+void led_matrix_headless_hash_reset(void);
+
+/**
+ * @brief   Get the number of times the refresh ISR has run so far
+ *
+ * @note    Only available with module `led_matrix_isr_count`
+ */
+uint32_t led_matrix_isr_count(void);
+
+/**
+ * @name    Animation encoding
+ *
+ * Every frame starts with a little endian 16 bit header holding the frame
+ * type in the upper two bits and the duration of the frame (in LED matrix
+ * frames) in the lower 14 bits. Frames of type
+ * @ref LED_MATRIX_ANIM_FRAME_RAW are followed by the frame buffer contents
+ * as is. The other frame types are followed by a sequence of one byte
+ * opcodes iterating over the pixels in frame buffer order until every
+ * pixel is covered:
+ *
+ * - `0b0nnnnnnn`: skip `n + 1` pixels
+ * - `0b1nnnbbbb`: set `n + 1` pixels to brightness `b`
+ *
+ * Skipped pixels remain blank in @ref LED_MATRIX_ANIM_FRAME_KEY frames and
+ * keep the value of the previous frame in @ref LED_MATRIX_ANIM_FRAME_DELTA
+ * frames. Use `led_matrix/dist/anim2c.py` to encode animations.
+ * @{
+ */
+#define LED_MATRIX_ANIM_FRAME_KEY       0U      /**< Run length encoded frame */
+#define LED_MATRIX_ANIM_FRAME_DELTA     1U      /**< Changes to the previous frame */
+#define LED_MATRIX_ANIM_FRAME_RAW       2U      /**< Uncompressed frame */
+#define LED_MATRIX_ANIM_TYPE_SHIFT      14U     /**< Position of the type in the header */
+#define LED_MATRIX_ANIM_DURATION_MASK   0x3fffU /**< Mask of the duration in the header */
+#define LED_MATRIX_ANIM_OP_RUN          0x80U   /**< Opcode flag for runs of pixels */
+/** @} */
+
+/**
+ * @brief   A full screen animation stored in the compressed format
+ */
+typedef struct {
+    const uint8_t *data;            /**< The encoded frames */
+    uint16_t frames_numof;          /**< Number of frames in @ref led_matrix_anim_t::data */
+} led_matrix_anim_t;
+
+/**
+ * @brief   State of an animation being played
+ */
+typedef struct {
+    const led_matrix_anim_t *anim;  /**< The animation played */
+    const uint8_t *next;            /**< Encoded data of the next frame */
+    uint16_t frame;                 /**< Index of the next frame */
+} led_matrix_anim_player_t;
+
+/**
+ * @brief   Prepare @p player to play @p anim from the first frame on
+ *
+ * @param[out]  player      The player state to initialize
+ * @param[in]   anim        The animation to play
+ */
+void led_matrix_anim_start(led_matrix_anim_player_t *player, const led_matrix_anim_t *anim);
+
+/**
+ * @brief   Decode the next frame of the animation into the scratch frame
+ *          buffer
+ *
+ * @param[in,out]   player  The player state
+ *
+ * @return  The number of LED matrix frames the decoded frame is to be shown
+ * @retval  0       The animation is over, the scratch buffer is unmodified
+ *
+ * @pre     Unless the decoded frame is the first one, the previous frame of
+ *          the animation is currently shown unmodified (as delta frames are
+ *          applied on top of the active frame buffer)
+ *
+ * @warning This function is not thread-safe. The caller must ensure
+ *          that no other thread is concurrently accessing the
+ *          LED matrix's frame buffers.
+ */
+uint16_t led_matrix_anim_decode_next(led_matrix_anim_player_t *player);
+
+/**
+ * @brief   Play the given animation and return once the last frame has been
+ *          shown for its full duration
+ *
+ * @param[in]   anim        The animation to play
+ *
+ * @warning This function is not thread-safe. The caller must ensure
+ *          that no other thread is concurrently accessing the
+ *          LED matrix's frame buffers.
+ */
+void led_matrix_anim_play(const led_matrix_anim_t *anim);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    drivers_led_matrix_bench  Rendering Benchmarks
+ * @ingroup     drivers_led_matrix
+ *
+ * With module `led_matrix_bench` the cost of code run in between frames,
+ * such as rendering or game logic, can be measured:
+ *
+ * - On Cortex-M in CPU cycles. The Cortex-M0+ has no cycle counter, but the
+ *   SysTick timer counts down at the core clock (24 bit). Interrupts are
+ *   disabled while measuring to keep the refresh ISR out of the measurement,
+ *   so a single measurement must take less than 2^24 cycles.
+ * - Elsewhere (e.g. on the `native` board) as wall time in nanoseconds from
+ *   @ref led_matrix_bench_init to @ref led_matrix_bench_print, including the
+ *   code in between measurements.
+ *
+ * On the hardware the module selects `stdio_rtt` to print the results, as
+ * the LED matrix is busy with the application.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `led_matrix_bench` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_BENCH_H
+#define LED_MATRIX_BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A benchmark in progress
+ *
+ * @note    All members are private
+ */
+typedef struct {
+#if MODULE_CORTEXM_COMMON
+    uint64_t cycles;        /**< Cycles measured so far */
+    uint32_t before;        /**< SysTick value at the start of the measurement */
+    unsigned irq_state;     /**< IRQ state to restore after the measurement */
+#else
+    uint32_t start;         /**< Time the benchmark was started at in µs */
+#endif
+    uint32_t numof;         /**< Number of measurements */
+} led_matrix_bench_t;
+
+/**
+ * @brief   Start a benchmark
+ *
+ * @param[out]  bench   The benchmark to start
+ */
+void led_matrix_bench_init(led_matrix_bench_t *bench);
+
+/**
+ * @brief   Start a measurement
+ *
+ * @param[in,out]   bench   The benchmark to add the measurement to
+ *
+ * @note    On Cortex-M this disables interrupts until @ref led_matrix_bench_end
+ */
+void led_matrix_bench_begin(led_matrix_bench_t *bench);
+
+/**
+ * @brief   End the measurement started by @ref led_matrix_bench_begin
+ *
+ * @param[in,out]   bench   The benchmark to add the measurement to
+ */
+void led_matrix_bench_end(led_matrix_bench_t *bench);
+
+/**
+ * @brief   Print the average cost of a measurement via stdio
+ *
+ * @param[in]   bench   The benchmark to print
+ * @param[in]   name    Name of the code measured
+ * @param[in]   unit    What a single measurement covers, e.g. `"frame"`
+ */
+void led_matrix_bench_print(const led_matrix_bench_t *bench, const char *name,
+                            const char *unit);
+
+/**
+ * @brief   Call after the last benchmark has been printed
+ *
+ * Off the hardware (e.g. on the `native` board) this terminates the
+ * application, so that the benchmarks can be run from scripts. On the
+ * hardware it returns and the application continues as usual.
+ */
+void led_matrix_bench_done(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_BENCH_H */
+/** @} */
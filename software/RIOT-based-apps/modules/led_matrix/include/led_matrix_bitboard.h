@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    drivers_led_matrix_bitboard  Monochrome Bitboards
+ * @ingroup     drivers_led_matrix
+ *
+ * A bitboard holds one bit per LED of the matrix, stored as one bit mask per
+ * column with bit 0 being the topmost row. This takes 20 bytes for the
+ * 10 x 9 matrix of the business card, compared to 45 bytes of a frame buffer
+ * with 4 bits per pixel.
+ *
+ * Games can keep their playfield (or any layer of it) in a bitboard and
+ * test for collisions by AND-ing two bitboards, which takes a handful of
+ * instructions per column. @ref led_matrix_bitboard_draw composites a
+ * bitboard into the scratch frame buffer two pixels at a time.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the bitboards of `led_matrix`
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_BITBOARD_H
+#define LED_MATRIX_BITBOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "led_matrix_params.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Bit mask of the rows of a column
+ */
+#define LED_MATRIX_BITBOARD_COLUMN_MASK ((1U << LED_MATRIX_HEIGHT) - 1)
+
+/**
+ * @brief   A monochrome image of the size of the LED matrix
+ *
+ * Bits beyond the bottom row must be zero.
+ */
+typedef struct {
+    uint16_t cols[LED_MATRIX_WIDTH];    /**< Bit mask of every column, bit 0 is the top row */
+} led_matrix_bitboard_t;
+
+/**
+ * @brief   Clear all bits of a bitboard
+ */
+static inline void led_matrix_bitboard_clear(led_matrix_bitboard_t *bb)
+{
+    memset(bb, 0, sizeof(*bb));
+}
+
+/**
+ * @brief   Set the bit of the given pixel, pixels out of bounds are ignored
+ */
+static inline void led_matrix_bitboard_set(led_matrix_bitboard_t *bb, int x, int y)
+{
+    if (((unsigned)x < LED_MATRIX_WIDTH) && ((unsigned)y < LED_MATRIX_HEIGHT)) {
+        bb->cols[x] |= 1U << y;
+    }
+}
+
+/**
+ * @brief   Get the bit of the given pixel, pixels out of bounds are not set
+ */
+static inline bool led_matrix_bitboard_get(const led_matrix_bitboard_t *bb, int x, int y)
+{
+    if (((unsigned)x < LED_MATRIX_WIDTH) && ((unsigned)y < LED_MATRIX_HEIGHT)) {
+        return (bb->cols[x] >> y) & 0x1;
+    }
+
+    return false;
+}
+
+/**
+ * @brief   Set all bits set in @p src in @p dest as well
+ */
+static inline void led_matrix_bitboard_or(led_matrix_bitboard_t *dest,
+                                          const led_matrix_bitboard_t *src)
+{
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        dest->cols[x] |= src->cols[x];
+    }
+}
+
+/**
+ * @brief   Clear all bits in @p dest that are not set in @p src
+ */
+static inline void led_matrix_bitboard_and(led_matrix_bitboard_t *dest,
+                                           const led_matrix_bitboard_t *src)
+{
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        dest->cols[x] &= src->cols[x];
+    }
+}
+
+/**
+ * @brief   Move the contents of a bitboard
+ *
+ * @param[in,out]   bb      The bitboard to shift
+ * @param[in]       dx      Columns to move to the right (negative: left)
+ * @param[in]       dy      Rows to move down (negative: up)
+ *
+ * Bits moved out of the board are lost, bits moved in are zero.
+ */
+static inline void led_matrix_bitboard_shift(led_matrix_bitboard_t *bb, int dx, int dy)
+{
+    /* iterate away from the direction of movement, so that no column is
+     * overwritten before it has been moved */
+    int step = (dx > 0) ? -1 : 1;
+    int x = (dx > 0) ? (int)LED_MATRIX_WIDTH - 1 : 0;
+
+    for (unsigned i = 0; i < LED_MATRIX_WIDTH; i++, x += step) {
+        int src = x - dx;
+        uint32_t col = ((unsigned)src < LED_MATRIX_WIDTH) ? bb->cols[src] : 0;
+        if (dy >= 0) {
+            col = (dy < (int)LED_MATRIX_HEIGHT) ? (col << dy) & LED_MATRIX_BITBOARD_COLUMN_MASK : 0;
+        }
+        else {
+            col = (-dy < (int)LED_MATRIX_HEIGHT) ? col >> -dy : 0;
+        }
+        bb->cols[x] = col;
+    }
+}
+
+/**
+ * @brief   Count the bits set in a column
+ *
+ * The Cortex-M0+ has no instruction for this, so the bits are summed up in
+ * parallel.
+ */
+static inline unsigned led_matrix_bitboard_popcount_column(uint32_t col)
+{
+    col = col - ((col >> 1) & 0x5555);
+    col = (col & 0x3333) + ((col >> 2) & 0x3333);
+    col = (col + (col >> 4)) & 0x0f0f;
+    return (col + (col >> 8)) & 0x1f;
+}
+
+/**
+ * @brief   Count the bits set in a bitboard
+ */
+static inline unsigned led_matrix_bitboard_popcount(const led_matrix_bitboard_t *bb)
+{
+    unsigned count = 0;
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        count += led_matrix_bitboard_popcount_column(bb->cols[x]);
+    }
+    return count;
+}
+
+/**
+ * @brief   Check if any bit is set in both bitboards, e.g. to detect a
+ *          collision
+ */
+static inline bool led_matrix_bitboard_overlaps(const led_matrix_bitboard_t *a,
+                                                const led_matrix_bitboard_t *b)
+{
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        if (a->cols[x] & b->cols[x]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief   Count the bits set in both bitboards, e.g. the pixels hit
+ */
+static inline unsigned led_matrix_bitboard_overlap_count(const led_matrix_bitboard_t *a,
+                                                         const led_matrix_bitboard_t *b)
+{
+    unsigned count = 0;
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        count += led_matrix_bitboard_popcount_column(a->cols[x] & b->cols[x]);
+    }
+    return count;
+}
+
+/**
+ * @brief   Draw the bits set in a bitboard into the scratch frame buffer
+ *
+ * @param[in]   bb          The bitboard to draw
+ * @param[in]   brightness  Brightness of the pixels set in @p bb
+ *
+ * Pixels not set in @p bb keep their brightness, so that bitboards can be
+ * layered. Use @ref led_matrix_fb_column to overwrite whole columns
+ * instead.
+ */
+void led_matrix_bitboard_draw(const led_matrix_bitboard_t *bb, uint8_t brightness);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_BITBOARD_H */
+/** @} */
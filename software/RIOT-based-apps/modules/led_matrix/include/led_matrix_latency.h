@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    drivers_led_matrix_latency  Input-to-Photon Latency Measurement
+ * @ingroup     drivers_led_matrix
+ *
+ * With module `led_matrix_latency` the time from a button press to the
+ * LED matrix showing the reaction to it is measured end-to-end:
+ *
+ * 1. The button scanner (`button_matrix_events`) notes the time of the
+ *    first scan that sees the button pressed, before debouncing
+ * 2. When the application takes the press event out of the queue, the
+ *    next frame passed to @ref led_matrix_fb_switch is tagged as the
+ *    response to it
+ * 3. When the refresh ISR first shows the tagged frame, the latency is
+ *    added to a histogram
+ *
+ * Time is counted in slots of the refresh ISR, of which there are
+ * @ref LED_MATRIX_SLOTS_PER_FRAME per frame. The histogram is binned by
+ * frames (rounded up), so that a run on the `native` board with scripted
+ * input (module `button_matrix_script`) yields the same report as a run on
+ * the hardware, as long as the application keeps up with the frame rate.
+ *
+ * If the application takes several press events before switching frames,
+ * only the oldest one is measured.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `led_matrix_latency` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_LATENCY_H
+#define LED_MATRIX_LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of bins of the latency histogram
+ *
+ * Bin `n` counts latencies of `n` frames, the last bin also counts all
+ * higher latencies.
+ */
+#ifndef CONFIG_LED_MATRIX_LATENCY_BINS
+#  define CONFIG_LED_MATRIX_LATENCY_BINS    12
+#endif
+
+/**
+ * @brief   Latency statistics
+ *
+ * All times are in slots of the refresh ISR
+ */
+typedef struct {
+    uint32_t bins[CONFIG_LED_MATRIX_LATENCY_BINS];  /**< Histogram binned by frames */
+    uint32_t numof;                                 /**< Number of measurements */
+    uint32_t sum;                                   /**< Sum of all latencies */
+    uint32_t min;                                   /**< Lowest latency */
+    uint32_t max;                                   /**< Highest latency */
+} led_matrix_latency_stats_t;
+
+/**
+ * @brief   Get the current time in slots of the refresh ISR
+ */
+uint32_t led_matrix_latency_now(void);
+
+/**
+ * @brief   Mark an input as handed to the application
+ *
+ * @param[in]   seen_at     Time the input was first seen, as returned by
+ *                          @ref led_matrix_latency_now
+ *
+ * The next frame passed to @ref led_matrix_fb_switch is considered as the
+ * response to the input. This is called by `button_matrix_events` when a
+ * press event is taken out of the queue.
+ */
+void led_matrix_latency_start(uint32_t seen_at);
+
+/**
+ * @brief   Take the pending input, if any
+ *
+ * @param[out]  seen_at     Time the pending input was first seen
+ *
+ * @retval  true    A pending input was taken and written to @p seen_at
+ * @retval  false   No input pending
+ *
+ * @note    Called by the LED matrix driver with IRQs disabled when a frame
+ *          switch is requested
+ */
+bool led_matrix_latency_take(uint32_t *seen_at);
+
+/**
+ * @brief   Add a latency to the statistics
+ *
+ * @param[in]   latency     Latency in slots of the refresh ISR
+ *
+ * @note    Called by the refresh ISR when a tagged frame is shown
+ */
+void led_matrix_latency_record(uint32_t latency);
+
+/**
+ * @brief   Get a copy of the statistics collected so far
+ *
+ * @param[out]  dest        Where to write the statistics to
+ */
+void led_matrix_latency_get(led_matrix_latency_stats_t *dest);
+
+/**
+ * @brief   Clear the statistics collected so far
+ */
+void led_matrix_latency_reset(void);
+
+/**
+ * @brief   Print the latency histogram via stdio
+ */
+void led_matrix_latency_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_LATENCY_H */
+/** @} */
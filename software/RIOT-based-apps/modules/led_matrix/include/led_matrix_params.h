@@ -25,11 +25,31 @@
 extern "C" {
 #endif
 
+#if MODULE_LED_MATRIX_VIRTUAL
+/* Without real hardware only the timer and the dimensions matter. Default
+ * to the 10 x 9 matrix of the business card */
+#  ifndef LED_MATRIX_TIMER
+#    define LED_MATRIX_TIMER    TIMER_DEV(0)
+#  endif
+#  ifndef LED_MATRIX_PIN_0
+#    define LED_MATRIX_PIN_0    0
+#    define LED_MATRIX_PIN_1    1
+#    define LED_MATRIX_PIN_2    2
+#    define LED_MATRIX_PIN_3    3
+#    define LED_MATRIX_PIN_4    4
+#    define LED_MATRIX_PIN_5    5
+#    define LED_MATRIX_PIN_6    6
+#    define LED_MATRIX_PIN_7    7
+#    define LED_MATRIX_PIN_8    8
+#    define LED_MATRIX_PIN_9    9
+#  endif
+#endif
+
 #ifndef LED_MATRIX_TIMER
 #  error "LED_MATRIX_TIMER not defined"
 #endif
 
-#ifndef LED_MATRIX_PORT
+#if !defined(LED_MATRIX_PORT) && !MODULE_LED_MATRIX_VIRTUAL
 #  error "LED_MATRIX_PORT not defined"
 #endif
 
@@ -92,6 +112,13 @@ static const uint8_t led_matrix_pins[] = {
  */
 #define LED_MATRIX_LED_NUMOF    (LED_MATRIX_WIDTH * LED_MATRIX_HEIGHT)
 
+/**
+ * @brief   Number of invocations of the refresh ISR per frame
+ *
+ * Every LED gets one time slot per brightness level above zero.
+ */
+#define LED_MATRIX_SLOTS_PER_FRAME  (LED_MATRIX_LED_NUMOF * LED_MATRIX_BRIGHTNESS_MAX)
+
 #ifdef __cplusplus
 }
 #endif
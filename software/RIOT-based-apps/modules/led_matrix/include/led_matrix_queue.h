@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    drivers_led_matrix_queue  Render Command Queue
+ * @ingroup     drivers_led_matrix
+ *
+ * The drawing functions of @ref drivers_led_matrix are not thread-safe. With
+ * module `led_matrix_queue` any number of threads (and ISRs) can draw
+ * nonetheless: They submit compact draw commands into a queue, and a single
+ * display thread executes them against the frame buffers.
+ *
+ * Commands are executed in the order they were submitted. All commands
+ * passed to one call of @ref led_matrix_queue_submit are queued at once, so
+ * that a frame drawn by one thread does not get commands of other threads
+ * mixed in.
+ *
+ * The frame buffer is retained: After a @ref LED_MATRIX_CMD_PRESENT, the
+ * display thread copies the frame shown into the scratch buffer, so that
+ * commands modify the frame currently shown. E.g. a status indicator can be
+ * updated by submitting just a pixel and a present command, while the
+ * game logic submits a clear command before drawing whole frames.
+ *
+ * The queue is a fixed pool of @ref CONFIG_LED_MATRIX_QUEUE_SIZE commands.
+ * There is only a single consumer, so taking commands out needs no locking.
+ * Producers reserve their slots with interrupts disabled for the duration of
+ * copying the commands in, as the Cortex-M0+ has no atomic compare-and-swap.
+ * Threads submitting into a full queue block until there is room, ISRs get
+ * an error instead.
+ *
+ * The display thread is started by @ref led_matrix_init.
+ *
+ * @warning With this module in use, the drawing functions of
+ *          @ref drivers_led_matrix must only be used by the display thread.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `led_matrix_queue` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_QUEUE_H
+#define LED_MATRIX_QUEUE_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bitmap_fonts.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of commands the queue can hold (must be a power of two)
+ */
+#ifndef CONFIG_LED_MATRIX_QUEUE_SIZE
+#  define CONFIG_LED_MATRIX_QUEUE_SIZE          16
+#endif
+
+/**
+ * @brief   Priority of the display thread
+ *
+ * The display thread only runs when commands are queued and sleeps while
+ * waiting for a frame buffer switch.
+ */
+#ifndef CONFIG_LED_MATRIX_QUEUE_PRIO
+#  define CONFIG_LED_MATRIX_QUEUE_PRIO          (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the display thread
+ */
+#ifndef CONFIG_LED_MATRIX_QUEUE_STACKSIZE
+#  define CONFIG_LED_MATRIX_QUEUE_STACKSIZE     THREAD_STACKSIZE_SMALL
+#endif
+
+/**
+ * @brief   Types of draw commands
+ */
+typedef enum {
+    LED_MATRIX_CMD_PIXEL,       /**< Set a pixel, see @ref led_matrix_fb_set */
+    LED_MATRIX_CMD_GLYPH,       /**< Draw a glyph, see @ref led_matrix_glyph */
+    LED_MATRIX_CMD_TEXT,        /**< Draw text, see @ref led_matrix_text */
+    LED_MATRIX_CMD_CLEAR,       /**< Clear the frame, see @ref led_matrix_fb_clear */
+    LED_MATRIX_CMD_PRESENT,     /**< Show the frame, see @ref led_matrix_fb_switch */
+} led_matrix_cmd_type_t;
+
+/**
+ * @brief   A draw command
+ *
+ * Use the `led_matrix_cmd_*()` functions to create them. Glyphs, fonts and
+ * text are referenced, not copied, so they must stay valid until the
+ * command has been executed (see @ref led_matrix_queue_flush).
+ */
+typedef struct {
+    uint8_t type        : 4;    /**< Type of the command, see @ref led_matrix_cmd_type_t */
+    uint8_t brightness  : 4;    /**< Brightness to draw with */
+    uint8_t len;                /**< Length of the text */
+    int8_t x;                   /**< Column to draw at */
+    int8_t y;                   /**< Row to draw at */
+    union {
+        const bitmap_glyph_t *glyph;    /**< Glyph to draw */
+        struct {
+            const bitmap_font_t *font;  /**< Font to draw the text in */
+            const char *text;           /**< Text to draw */
+        };
+        uint32_t frame;                 /**< Frame number to show the frame at */
+    };
+} led_matrix_cmd_t;
+
+/**
+ * @brief   Create a command setting a pixel
+ */
+static inline led_matrix_cmd_t led_matrix_cmd_pixel(int x, int y, uint8_t brightness)
+{
+    return (led_matrix_cmd_t){
+        .type = LED_MATRIX_CMD_PIXEL, .brightness = brightness, .x = x, .y = y,
+    };
+}
+
+/**
+ * @brief   Create a command drawing a glyph
+ */
+static inline led_matrix_cmd_t led_matrix_cmd_glyph(const bitmap_glyph_t *glyph,
+                                                    int x, int y, uint8_t brightness)
+{
+    return (led_matrix_cmd_t){
+        .type = LED_MATRIX_CMD_GLYPH, .brightness = brightness, .x = x, .y = y,
+        .glyph = glyph,
+    };
+}
+
+/**
+ * @brief   Create a command drawing text
+ *
+ * @pre     @p len is at most `UINT8_MAX`
+ */
+static inline led_matrix_cmd_t led_matrix_cmd_text(const bitmap_font_t *font,
+                                                   const char *text, size_t len,
+                                                   int x, int y, uint8_t brightness)
+{
+    assert(len <= UINT8_MAX);
+    return (led_matrix_cmd_t){
+        .type = LED_MATRIX_CMD_TEXT, .brightness = brightness, .len = len,
+        .x = x, .y = y, .font = font, .text = text,
+    };
+}
+
+/**
+ * @brief   Create a command clearing the frame
+ */
+static inline led_matrix_cmd_t led_matrix_cmd_clear(void)
+{
+    return (led_matrix_cmd_t){ .type = LED_MATRIX_CMD_CLEAR };
+}
+
+/**
+ * @brief   Create a command showing the frame drawn so far
+ *
+ * @param[in]   frame   Number of the frame to show it at, as in
+ *                      @ref led_matrix_fb_switch
+ *
+ * The display thread waits for the switch before executing the next
+ * command.
+ */
+static inline led_matrix_cmd_t led_matrix_cmd_present(uint32_t frame)
+{
+    return (led_matrix_cmd_t){ .type = LED_MATRIX_CMD_PRESENT, .frame = frame };
+}
+
+/**
+ * @brief   Queue the given commands for execution by the display thread
+ *
+ * @param[in]   cmds    The commands to queue
+ * @param[in]   numof   Number of commands in @p cmds
+ *
+ * @pre     @p numof is at most @ref CONFIG_LED_MATRIX_QUEUE_SIZE
+ *
+ * In thread context this blocks until all commands fit into the queue.
+ *
+ * @retval  0           All commands queued
+ * @retval  -EAGAIN     Called from ISR context and the commands did not fit,
+ *                      none of them were queued
+ */
+int led_matrix_queue_submit(const led_matrix_cmd_t *cmds, unsigned numof);
+
+/**
+ * @brief   Block until all commands queued so far have been executed
+ *
+ * @pre     Not called from ISR context
+ */
+void led_matrix_queue_flush(void);
+
+/**
+ * @brief   Get the number of commands dropped due to the queue being full
+ *          in ISR context
+ */
+uint32_t led_matrix_queue_dropped(void);
+
+/**
+ * @brief   Start the display thread
+ *
+ * @note    This is called by @ref led_matrix_init
+ */
+void led_matrix_queue_init(void);
+
+/**
+ * @brief   Notify the display thread about a frame buffer switch
+ *
+ * @note    This is called by the refresh ISR
+ */
+void led_matrix_queue_switched(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_QUEUE_H */
+/** @} */
@@ -1,13 +1,19 @@
 #include "atomic_utils.h"
 #include "bitmap_fonts.h"
-#include "clk.h"
 #include "compiler_hints.h"
 #include "irq.h"
 #include "led_matrix.h"
+#include "led_matrix_bitboard.h"
 #include "led_matrix_params.h"
-#include "periph/gpio_ll.h"
 #include "periph/timer.h"
+#include "timex.h"
 
+#if !MODULE_LED_MATRIX_VIRTUAL
+#include "clk.h"
+#include "periph/gpio_ll.h"
+#endif
+
+#include <assert.h>
 #include <string.h>
 
 #if MODULE_BUTTON_MATRIX
@@ -15,13 +21,49 @@
 #include "button_matrix_params.h"
 #endif /* MODULE_BUTTON_MATRIX */
 
+#if MODULE_BUTTON_MATRIX_EVENTS
+#include "button_matrix_events.h"
+#endif /* MODULE_BUTTON_MATRIX_EVENTS */
+
+#if MODULE_BUTTON_MATRIX_EVENTS_LED
+static bool button_scan_pending;
+static uint8_t button_scan_countdown = 1;
+#endif
+
+#if MODULE_LED_MATRIX_QUEUE
+#include "led_matrix_queue.h"
+#endif
+
+#if MODULE_LED_MATRIX_ISR_COUNT
+static uint32_t isr_count;
+#endif
+
+#if MODULE_LED_MATRIX_LATENCY
+#include "led_matrix_latency.h"
+
+static uint32_t refresh_ticks;
+static uint32_t switch_input_at;
+static bool switch_is_response;
+#endif
+
+
+#if MODULE_LED_MATRIX_HEADLESS
+#include <inttypes.h>
+#include <stdio.h>
+
+static uint32_t headless_hash = 2166136261U;
+static void virtual_frame(void);
+#endif
 
 #define LED_MATRIX_TEXT_SCROLL_FRAMES   4
 
+#if !MODULE_LED_MATRIX_VIRTUAL
 static uword_t led_out_masks[LED_MATRIX_PIN_NUMOF];
 static uword_t led_dir_masks[LED_MATRIX_PIN_NUMOF];
 static uword_t led_out_mask_all;
 static uword_t led_dir_mask_all;
+static uint32_t slot_period;
+#endif
 
 static uint8_t fb1[(LED_MATRIX_LED_NUMOF * LED_MATRIX_BRIGHTNESS_BITS + 7) / 8];
 static uint8_t fb2[(LED_MATRIX_LED_NUMOF * LED_MATRIX_BRIGHTNESS_BITS + 7) / 8];
@@ -32,6 +74,12 @@ static uint8_t *fb_scratch = fb2;
 static uint32_t frames;
 static uint32_t frame_switch_target;
 static uint8_t frame_switch_request;
+static uint8_t refresh_mode;
+
+void led_matrix_set_refresh(led_matrix_refresh_t mode)
+{
+    atomic_store_u8(&refresh_mode, mode);
+}
 
 void led_matrix_fb_set(int x, int y, uint8_t brightness)
 {
@@ -45,20 +93,117 @@ void led_matrix_fb_set(int x, int y, uint8_t brightness)
     fb_scratch[pos >> 3] |= brightness << (pos & 0x7);
 }
 
+/* column blits address pixels as nibbles */
+static_assert(LED_MATRIX_BRIGHTNESS_BITS == 4, "column blits need 4 bit per pixel");
+
+/* write the pixels of column x selected by mask, the others are cleared if
+ * opaque and kept otherwise */
+static inline __attribute__((always_inline))
+void _column(unsigned x, unsigned mask, uint8_t brightness, bool opaque)
+{
+    brightness &= LED_MATRIX_BRIGHTNESS_MAX;
+    /* the byte to write for every combination of two pixels, and the bits
+     * of the byte to keep */
+    const uint8_t pairs[4] = {
+        0, brightness, brightness << 4, brightness | (brightness << 4),
+    };
+    const uint8_t keep[4] = {
+        opaque ? 0x00 : 0xff, opaque ? 0x00 : 0xf0, opaque ? 0x00 : 0x0f, 0x00,
+    };
+
+    size_t pos = (size_t)x * LED_MATRIX_HEIGHT;
+    uint8_t *dest = &fb_scratch[pos >> 1];
+    unsigned y = 0;
+
+    /* a column starting in the upper nibble shares the byte with the
+     * previous one */
+    if (pos & 0x1) {
+        unsigned m = (mask & 0x1) << 1;
+        *dest = (*dest & (0x0f | keep[m])) | pairs[m];
+        dest++;
+        mask >>= 1;
+        y++;
+    }
+
+    for (; y + 2 <= LED_MATRIX_HEIGHT; y += 2) {
+        unsigned m = mask & 0x3;
+        *dest = (*dest & keep[m]) | pairs[m];
+        dest++;
+        mask >>= 2;
+    }
+
+    if (y < LED_MATRIX_HEIGHT) {
+        unsigned m = mask & 0x1;
+        *dest = (*dest & (0xf0 | keep[m])) | pairs[m];
+    }
+}
+
+void led_matrix_fb_column(int x, unsigned mask, uint8_t brightness)
+{
+    if ((unsigned)x >= LED_MATRIX_WIDTH) {
+        return;
+    }
+
+    _column(x, mask, brightness, true);
+}
+
+void led_matrix_bitboard_draw(const led_matrix_bitboard_t *bb, uint8_t brightness)
+{
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        _column(x, bb->cols[x], brightness, false);
+    }
+}
+
 void led_matrix_fb_clear(void)
 {
     memset(fb_scratch, 0, sizeof(fb1));
 }
 
-uint32_t led_matrix_fb_switch(uint32_t at_frame_number)
+void led_matrix_fb_copy_active(void)
+{
+    /* the refresh ISR only reads the active buffer */
+    memcpy(fb_scratch, fb_active, sizeof(fb1));
+}
+
+uint8_t *led_matrix_fb_scratch(void)
+{
+    return fb_scratch;
+}
+
+void led_matrix_fb_switch_request(uint32_t at_frame_number)
 {
     unsigned irq_state = irq_disable();
     frame_switch_target = at_frame_number;
     frame_switch_request = 1;
+#if MODULE_LED_MATRIX_LATENCY
+    switch_is_response = led_matrix_latency_take(&switch_input_at);
+#endif
     irq_restore(irq_state);
+}
+
+bool led_matrix_fb_switch_done(uint32_t *frame_number)
+{
+    if (atomic_load_u8(&frame_switch_request)) {
+        return false;
+    }
+
+    if (frame_number) {
+        *frame_number = atomic_load_u32(&frame_switch_target);
+    }
+    return true;
+}
+
+uint32_t led_matrix_fb_switch(uint32_t at_frame_number)
+{
+    led_matrix_fb_switch_request(at_frame_number);
 
     while (atomic_load_u8(&frame_switch_request)) {
+#if MODULE_LED_MATRIX_HEADLESS
+        /* nobody else is going to advance time */
+        virtual_frame();
+#else
         /* busy wait */
+#endif
     }
 
     /* The atomic_load_u32() will not provide thread-safety here,
@@ -71,6 +216,139 @@ uint32_t led_matrix_fb_switch(uint32_t at_frame_number)
     return atomic_load_u32(&frame_switch_target);
 }
 
+#if MODULE_LED_MATRIX_HEADLESS
+static uint32_t fnv1a(uint32_t hash, const uint8_t *data, size_t len)
+{
+    while (len--) {
+        hash = (hash ^ *data++) * 16777619U;
+    }
+    return hash;
+}
+
+static void headless_frame_shown(void)
+{
+    uint32_t hash = fnv1a(2166136261U, fb_active, sizeof(fb1));
+
+    /* chain the hashes along with the frame numbers, so that the timing of
+     * frame switches counts as well */
+    headless_hash = fnv1a(headless_hash, (const uint8_t *)&frames, sizeof(frames));
+    headless_hash = fnv1a(headless_hash, (const uint8_t *)&hash, sizeof(hash));
+
+    if (CONFIG_LED_MATRIX_HEADLESS_PRINT_FRAMES) {
+        printf("frame %" PRIu32 ": %08" PRIx32 "\n", frames, hash);
+    }
+}
+
+uint32_t led_matrix_headless_hash(void)
+{
+    return headless_hash;
+}
+
+void led_matrix_headless_hash_reset(void)
+{
+    headless_hash = 2166136261U;
+}
+#endif
+
+#if MODULE_LED_MATRIX_ISR_COUNT
+uint32_t led_matrix_isr_count(void)
+{
+    return atomic_load_u32(&isr_count);
+}
+#endif
+
+#if MODULE_LED_MATRIX_LATENCY
+uint32_t led_matrix_latency_now(void)
+{
+    return atomic_load_u32(&refresh_ticks);
+}
+#endif
+
+/* called by the refresh ISR whenever the last slot of a frame has been
+ * shown */
+static void frame_done(void)
+{
+    frames++;
+
+#if MODULE_BUTTON_MATRIX_EVENTS_LED
+    if (--button_scan_countdown == 0) {
+        button_scan_countdown = CONFIG_BUTTON_MATRIX_EVENTS_LED_FRAMES;
+        button_scan_pending = true;
+    }
+#endif
+
+    if (frame_switch_request && (frame_switch_target - frames > UINT16_MAX)) {
+        uint8_t *tmp = fb_active;
+        fb_active = fb_scratch;
+        fb_scratch = tmp;
+        frame_switch_target = frames;
+        frame_switch_request = 0;
+#if MODULE_LED_MATRIX_LATENCY
+        if (switch_is_response) {
+            switch_is_response = false;
+            led_matrix_latency_record(refresh_ticks - switch_input_at);
+        }
+#endif
+#if MODULE_LED_MATRIX_HEADLESS
+        headless_frame_shown();
+#endif
+#if MODULE_LED_MATRIX_QUEUE
+        led_matrix_queue_switched();
+#endif
+    }
+}
+
+#if MODULE_LED_MATRIX_VIRTUAL
+/* everything the refresh ISR does in one frame */
+static void virtual_frame(void)
+{
+#if MODULE_BUTTON_MATRIX_EVENTS_LED
+    /* On the hardware the scan completes a few slots into the frame, after
+     * the thread waiting for the frame switch has been woken up. Completing
+     * it only at the end of the frame keeps the order of events the same */
+    while (button_scan_pending) {
+        button_scan_pending = button_matrix_events_scan_step(frames);
+    }
+#endif
+
+#if MODULE_LED_MATRIX_LATENCY
+    refresh_ticks += LED_MATRIX_SLOTS_PER_FRAME;
+#endif
+
+    frame_done();
+}
+#endif /* MODULE_LED_MATRIX_VIRTUAL */
+
+#if MODULE_LED_MATRIX_HEADLESS
+static int _init(void)
+{
+    /* frames are advanced on demand by whoever waits for them */
+    return 0;
+}
+#elif MODULE_LED_MATRIX_VIRTUAL
+static void led_timer_cb(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+
+    /* no LEDs to multiplex, so the ISR runs once per frame */
+    timer_set(LED_MATRIX_TIMER, 0, US_PER_SEC / LED_MATRIX_FPS);
+#if MODULE_LED_MATRIX_ISR_COUNT
+    isr_count++;
+#endif
+    virtual_frame();
+}
+
+static int _init(void)
+{
+    int retval = timer_init(LED_MATRIX_TIMER, US_PER_SEC, led_timer_cb, NULL);
+    if (retval != 0) {
+        return retval;
+    }
+
+    return timer_set(LED_MATRIX_TIMER, 0, US_PER_SEC / LED_MATRIX_FPS);
+}
+#else /* MODULE_LED_MATRIX_HEADLESS / MODULE_LED_MATRIX_VIRTUAL */
 static void led_timer_cb(void *arg, int chan)
 {
     (void)arg;
@@ -78,10 +356,28 @@ static void led_timer_cb(void *arg, int chan)
     static unsigned x = 0;
     static unsigned y = 0;
     static unsigned b = 1;
+    static bool mono = false;
 
     gpio_ll_switch_dir_input(LED_MATRIX_PORT, led_dir_mask_all);
     gpio_ll_clear(LED_MATRIX_PORT, led_out_mask_all);
 
+#if MODULE_LED_MATRIX_ISR_COUNT
+    isr_count++;
+#endif
+
+#if MODULE_LED_MATRIX_LATENCY
+    /* ticks count grayscale slots */
+    refresh_ticks += mono ? LED_MATRIX_BRIGHTNESS_MAX : 1;
+#endif
+
+#if MODULE_BUTTON_MATRIX_EVENTS_LED
+    /* The buttons are on a different GPIO port. One scan step per pixel
+     * gives the inputs a full pixel period to settle, no need to busy wait */
+    if (button_scan_pending) {
+        button_scan_pending = button_matrix_events_scan_step(frames);
+    }
+#endif
+
     size_t pos = (x * LED_MATRIX_HEIGHT + y) * LED_MATRIX_BRIGHTNESS_BITS;
 
     if (((fb_active[pos >> 3] >> (pos & 0x7)) & LED_MATRIX_BRIGHTNESS_MAX) >= b) {
@@ -96,23 +392,25 @@ static void led_timer_cb(void *arg, int chan)
         y = 0;
         if (++x == LED_MATRIX_WIDTH) {
             x = 0;
-            if (++b == LED_MATRIX_BRIGHTNESS_LEVELS) {
-                frames++;
+            /* in mono mode b stays 1, so every LED not off is lit */
+            if (mono || (++b == LED_MATRIX_BRIGHTNESS_LEVELS)) {
                 b = 1;
-
-                if (frame_switch_request && (frame_switch_target - frames > UINT16_MAX)) {
-                    uint8_t *tmp = fb_active;
-                    fb_active = fb_scratch;
-                    fb_scratch = tmp;
-                    frame_switch_target = frames;
-                    frame_switch_request = 0;
+                frame_done();
+
+                /* switch the refresh mode only between frames */
+                if (mono != (refresh_mode == LED_MATRIX_REFRESH_MONO)) {
+                    mono = !mono;
+                    timer_set_periodic(LED_MATRIX_TIMER, 0,
+                                       mono ? slot_period * LED_MATRIX_BRIGHTNESS_MAX
+                                            : slot_period,
+                                       TIM_FLAG_RESET_ON_MATCH | TIM_FLAG_RESET_ON_SET);
                 }
             }
         }
     }
 }
 
-int led_matrix_init(void)
+static int _init(void)
 {
     int retval;
 
@@ -141,16 +439,33 @@ int led_matrix_init(void)
         return retval;
     }
 
-    const uint32_t fps = 60;
-    unsigned period = timer_freq / (fps * LED_MATRIX_LED_NUMOF * LED_MATRIX_BRIGHTNESS_MAX);
-    return timer_set_periodic(LED_MATRIX_TIMER, 0, period,
+    slot_period = timer_freq / (LED_MATRIX_FPS * LED_MATRIX_SLOTS_PER_FRAME);
+    return timer_set_periodic(LED_MATRIX_TIMER, 0, slot_period,
                               TIM_FLAG_RESET_ON_MATCH | TIM_FLAG_RESET_ON_SET);
 }
+#endif /* MODULE_LED_MATRIX_HEADLESS / MODULE_LED_MATRIX_VIRTUAL */
+
+int led_matrix_init(void)
+{
+    int retval = _init();
+
+#if MODULE_LED_MATRIX_QUEUE
+    if (retval == 0) {
+        led_matrix_queue_init();
+    }
+#endif
+
+    return retval;
+}
 
 void led_matrix_wait_for_frame(uint32_t frame_number)
 {
     while ((frame_number - atomic_load_u32(&frames)) <= UINT16_MAX) {
+#if MODULE_LED_MATRIX_HEADLESS
+        virtual_frame();
+#else
         /* spinning */
+#endif
     }
 }
 
@@ -159,6 +474,28 @@ uint32_t led_matrix_frame_number(void)
     return atomic_load_u32(&frames);
 }
 
+static inline __attribute__((always_inline))
+void _glyph(const bitmap_glyph_t *glyph, int xoffset, int yoffset, uint8_t brightness,
+            unsigned height)
+{
+    /* only visit the columns that are on screen */
+    int x = (xoffset < 0) ? -xoffset : 0;
+    int x_end = (int)LED_MATRIX_WIDTH - xoffset;
+    if (x_end > glyph->width) {
+        x_end = glyph->width;
+    }
+
+    for (; x < x_end; x++) {
+        /* with height being a compile time constant, this is folded */
+        unsigned col = (height <= 8) ? glyph->data[x] : bitmap_glyph_column(glyph, x);
+        for (unsigned y = 0; y < height; y++) {
+            if (col & (1U << y)) {
+                led_matrix_fb_set(x + xoffset, y + yoffset, brightness);
+            }
+        }
+    }
+}
+
 void led_matrix_glyph(const bitmap_glyph_t *glyph, int xoffset, int yoffset, uint8_t brightness)
 {
     assert(glyph != NULL);
@@ -171,14 +508,18 @@ void led_matrix_glyph(const bitmap_glyph_t *glyph, int xoffset, int yoffset, uin
         return;
     }
 
-    for (int x = 0; x < glyph->width; x++) {
-        for (int y = 0; y < 8; y++) {
-            if (bitmap_glyph_at(glyph, x, y)) {
-                led_matrix_fb_set(x + xoffset, y + yoffset, brightness);
-            }
-        }
+    /* provide specialized renderers for the font heights in use */
+    switch (glyph->height) {
+    case 8:
+        _glyph(glyph, xoffset, yoffset, brightness, 8);
+        break;
+    case 5:
+        _glyph(glyph, xoffset, yoffset, brightness, 5);
+        break;
+    default:
+        _glyph(glyph, xoffset, yoffset, brightness, glyph->height);
+        break;
     }
-
 }
 
 void led_matrix_text(const bitmap_font_t *font, const char *text, size_t len,
@@ -195,8 +536,12 @@ void led_matrix_text(const bitmap_font_t *font, const char *text, size_t len,
     led_matrix_glyph(&left, xoffset, yoffset, brightness);
 
     for (int i = 1; i < (int)len; i++) {
-        bitmap_glyph_t right = bitmap_font_get(font, text[i]);
         xoffset += left.width;
+        if (xoffset >= (int)LED_MATRIX_WIDTH) {
+            /* remaining glyphs are off screen */
+            return;
+        }
+        bitmap_glyph_t right = bitmap_font_get(font, text[i]);
         xoffset += bitmap_glyph_space_between(&left, &right);
 
         led_matrix_glyph(&right, xoffset, yoffset, brightness);
@@ -205,22 +550,112 @@ void led_matrix_text(const bitmap_font_t *font, const char *text, size_t len,
     }
 }
 
-void led_matrix_text_scroll(const bitmap_font_t *font, const char *text, size_t len,
-                            uint8_t brightness)
+/**
+ * @brief   Either text to render with a font, or a pre-rendered image
+ */
+struct scroll_content {
+    const bitmap_font_t *font;      /**< Font to render text in, or NULL */
+    const char *text;               /**< Text to render */
+    size_t len;                     /**< Length of text */
+    const bitmap_glyph_t *image;    /**< Pre-rendered image, if font is NULL */
+    led_matrix_scroll_speed_t speed;    /**< Frames per column, or NULL */
+    void *speed_arg;                /**< Argument of speed */
+};
+
+static bool _scroll(const struct scroll_content *c, uint8_t brightness,
+                    const uint8_t *btn_filter, uint8_t *btn_target, size_t btn_len)
 {
     int xshift;
-    int xshift_end = -(int)bitmap_font_render_width(font, text, len) - 1;
-    int yshift = (LED_MATRIX_HEIGHT - 8 + 1) / 2;
+    int width, height;
+    if (c->font) {
+        width = bitmap_font_render_width(c->font, c->text, c->len);
+        height = c->font->height;
+    }
+    else {
+        width = c->image->width;
+        height = c->image->height;
+    }
+    int xshift_end = -width - 1;
+    int yshift = ((int)LED_MATRIX_HEIGHT - height + 1) / 2;
 
     uint32_t frame_target = led_matrix_frame_number();
 
     led_matrix_fb_clear();
 
-    for (xshift = LED_MATRIX_WIDTH - 1; xshift > xshift_end; xshift--) {
-        led_matrix_text(font, text, len, xshift, yshift, brightness);
-        frame_target = led_matrix_fb_switch(frame_target) + LED_MATRIX_TEXT_SCROLL_FRAMES;
-        led_matrix_fb_clear();
-    }
+    do {
+        for (xshift = LED_MATRIX_WIDTH - 1; xshift > xshift_end; xshift--) {
+            unsigned frames_per_step = LED_MATRIX_TEXT_SCROLL_FRAMES;
+            if (c->speed) {
+                frames_per_step = c->speed(c->speed_arg);
+                if (frames_per_step == 0) {
+                    /* the scratch buffer is blank at this point */
+                    led_matrix_fb_switch(frame_target);
+                    return false;
+                }
+            }
+            if (c->font) {
+                led_matrix_text(c->font, c->text, c->len, xshift, yshift, brightness);
+            }
+            else {
+                led_matrix_glyph(c->image, xshift, yshift, brightness);
+            }
+            frame_target = led_matrix_fb_switch(frame_target) + frames_per_step;
+#if MODULE_BUTTON_MATRIX_EVENTS
+            button_matrix_event_t event;
+            while (btn_filter && button_matrix_events_try_get(&event)) {
+                uint8_t mask = 1U << (event.button & 0x7);
+                if ((event.type == BUTTON_MATRIX_EVENT_PRESS)
+                        && (btn_filter[event.button >> 3] & mask)) {
+                    button_matrix_events_state(btn_target);
+                    btn_target[event.button >> 3] |= mask;
+                    return true;
+                }
+            }
+            (void)btn_len;
+#elif MODULE_BUTTON_MATRIX
+            if (btn_filter) {
+                button_matrix_scan(btn_target);
+                for (size_t i = 0; i < btn_len; i++) {
+                    if (btn_filter[i] & btn_target[i]) {
+                        return true;
+                    }
+                }
+            }
+#else
+            (void)btn_target;
+            (void)btn_len;
+#endif
+            led_matrix_fb_clear();
+        }
+    } while (btn_filter);
+
+    return false;
+}
+
+void led_matrix_text_scroll(const bitmap_font_t *font, const char *text, size_t len,
+                            uint8_t brightness)
+{
+    assert((font != NULL) && (text != NULL));
+    const struct scroll_content c = { .font = font, .text = text, .len = len };
+    _scroll(&c, brightness, NULL, NULL, 0);
+}
+
+void led_matrix_text_scroll_adaptive(const bitmap_font_t *font, const char *text,
+                                     size_t len, uint8_t brightness,
+                                     led_matrix_scroll_speed_t speed, void *arg)
+{
+    assert((font != NULL) && (text != NULL) && (speed != NULL));
+    const struct scroll_content c = {
+        .font = font, .text = text, .len = len, .speed = speed, .speed_arg = arg,
+    };
+    _scroll(&c, brightness, NULL, NULL, 0);
+}
+
+void led_matrix_image_scroll(const bitmap_glyph_t *image, uint8_t brightness)
+{
+    assert(image != NULL);
+    const struct scroll_content c = { .image = image };
+    _scroll(&c, brightness, NULL, NULL, 0);
 }
 
 #if MODULE_BUTTON_MATRIX
@@ -233,26 +668,115 @@ void led_matrix_text_scroll_until_button(const bitmap_font_t *font,
 {
     assume((btn_filter != NULL) && (btn_target != NULL));
     assume(btn_len == (BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8);
-    int xshift;
-    int xshift_end = -(int)bitmap_font_render_width(font, text, len) - 1;
+    assert((font != NULL) && (text != NULL));
+    const struct scroll_content c = { .font = font, .text = text, .len = len };
+    _scroll(&c, brightness, btn_filter, btn_target, btn_len);
+}
 
-    uint32_t frame_target = led_matrix_frame_number();
+void led_matrix_image_scroll_until_button(const bitmap_glyph_t *image,
+                                          const uint8_t *btn_filter,
+                                          uint8_t *btn_target,
+                                          size_t btn_len,
+                                          uint8_t brightness)
+{
+    assume((btn_filter != NULL) && (btn_target != NULL));
+    assume(btn_len == (BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8);
+    assert(image != NULL);
+    const struct scroll_content c = { .image = image };
+    _scroll(&c, brightness, btn_filter, btn_target, btn_len);
+}
+#endif /* MODULE_BUTTON_MATRIX */
 
-    led_matrix_fb_clear();
+/* the animation decoder addresses pixels as nibbles */
+static_assert(LED_MATRIX_BRIGHTNESS_BITS == 4, "animations need 4 bit per pixel");
 
-    while (1) {
-        int yshift = (LED_MATRIX_HEIGHT - 8 + 1) / 2;
-        for (xshift = LED_MATRIX_WIDTH - 1; xshift > xshift_end; xshift--) {
-            led_matrix_text(font, text, len, xshift, yshift, brightness);
-            frame_target = led_matrix_fb_switch(frame_target) + LED_MATRIX_TEXT_SCROLL_FRAMES;
-            button_matrix_scan(btn_target);
-            for (size_t i = 0; i < btn_len; i++) {
-                if (btn_filter[i] & btn_target[i]) {
-                    return;
-                }
-            }
-            led_matrix_fb_clear();
+static const uint8_t *_anim_ops(const uint8_t *data)
+{
+    unsigned pos = 0;
+
+    while (pos < LED_MATRIX_LED_NUMOF) {
+        unsigned op = *data++;
+        if (!(op & LED_MATRIX_ANIM_OP_RUN)) {
+            /* skip unchanged pixels */
+            pos += op + 1;
+            continue;
+        }
+
+        unsigned len = ((op >> 4) & 0x7) + 1;
+        unsigned val = op & LED_MATRIX_BRIGHTNESS_MAX;
+        unsigned pattern = val | (val << 4);
+
+        /* set leading odd pixel, then two pixels per byte, then trailing pixel */
+        if (pos & 0x1) {
+            fb_scratch[pos >> 1] = (fb_scratch[pos >> 1] & 0x0f) | (val << 4);
+            pos++;
+            len--;
+        }
+        for (; len >= 2; len -= 2) {
+            fb_scratch[pos >> 1] = pattern;
+            pos += 2;
+        }
+        if (len) {
+            fb_scratch[pos >> 1] = (fb_scratch[pos >> 1] & 0xf0) | val;
+            pos++;
         }
     }
+
+    assert(pos == LED_MATRIX_LED_NUMOF);
+    return data;
+}
+
+void led_matrix_anim_start(led_matrix_anim_player_t *player, const led_matrix_anim_t *anim)
+{
+    assert((player != NULL) && (anim != NULL));
+    player->anim = anim;
+    player->next = anim->data;
+    player->frame = 0;
+}
+
+uint16_t led_matrix_anim_decode_next(led_matrix_anim_player_t *player)
+{
+    assert(player != NULL);
+    if (player->frame >= player->anim->frames_numof) {
+        return 0;
+    }
+
+    const uint8_t *data = player->next;
+    unsigned header = data[0] | ((unsigned)data[1] << 8);
+    data += 2;
+
+    switch (header >> LED_MATRIX_ANIM_TYPE_SHIFT) {
+    case LED_MATRIX_ANIM_FRAME_KEY:
+        memset(fb_scratch, 0, sizeof(fb1));
+        data = _anim_ops(data);
+        break;
+    case LED_MATRIX_ANIM_FRAME_DELTA:
+        /* the frame currently shown is the previous frame of the animation */
+        memcpy(fb_scratch, fb_active, sizeof(fb1));
+        data = _anim_ops(data);
+        break;
+    default:
+        memcpy(fb_scratch, data, sizeof(fb1));
+        data += sizeof(fb1);
+        break;
+    }
+
+    player->next = data;
+    player->frame++;
+
+    return header & LED_MATRIX_ANIM_DURATION_MASK;
+}
+
+void led_matrix_anim_play(const led_matrix_anim_t *anim)
+{
+    led_matrix_anim_player_t player;
+    led_matrix_anim_start(&player, anim);
+
+    uint32_t frame_target = led_matrix_frame_number();
+    uint16_t duration;
+    while ((duration = led_matrix_anim_decode_next(&player))) {
+        frame_target = led_matrix_fb_switch(frame_target) + duration;
+    }
+
+    led_matrix_wait_for_frame(frame_target);
 }
-#endif /* MODULE_BUTTON_MATRIX */
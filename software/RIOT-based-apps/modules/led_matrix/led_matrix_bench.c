@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_led_matrix_bench
+ * @{
+ *
+ * @file
+ * @brief       Cycle counting via SysTick, or wall time elsewhere
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "led_matrix_bench.h"
+
+#if MODULE_CORTEXM_COMMON
+#include "cpu.h"
+#include "irq.h"
+#else
+#include "periph/pm.h"
+#include "ztimer.h"
+#endif
+
+void led_matrix_bench_init(led_matrix_bench_t *bench)
+{
+    bench->numof = 0;
+#if MODULE_CORTEXM_COMMON
+    bench->cycles = 0;
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#else
+    bench->start = ztimer_now(ZTIMER_USEC);
+#endif
+}
+
+void led_matrix_bench_begin(led_matrix_bench_t *bench)
+{
+#if MODULE_CORTEXM_COMMON
+    bench->irq_state = irq_disable();
+    bench->before = SysTick->VAL;
+#else
+    (void)bench;
+#endif
+}
+
+void led_matrix_bench_end(led_matrix_bench_t *bench)
+{
+#if MODULE_CORTEXM_COMMON
+    /* SysTick counts down */
+    bench->cycles += (bench->before - SysTick->VAL) & SysTick_LOAD_RELOAD_Msk;
+    irq_restore(bench->irq_state);
+#endif
+    bench->numof++;
+}
+
+void led_matrix_bench_print(const led_matrix_bench_t *bench, const char *name,
+                            const char *unit)
+{
+    if (!bench->numof) {
+        return;
+    }
+
+#if MODULE_CORTEXM_COMMON
+    printf("%s: %" PRIu32 " cycles per %s\n", name,
+           (uint32_t)(bench->cycles / bench->numof), unit);
+#else
+    uint32_t us = ztimer_now(ZTIMER_USEC) - bench->start;
+    printf("%s: %" PRIu32 " ns per %s\n", name,
+           (uint32_t)((uint64_t)us * 1000 / bench->numof), unit);
+#endif
+}
+
+void led_matrix_bench_done(void)
+{
+#if !MODULE_CORTEXM_COMMON
+    pm_off();
+#endif
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_led_matrix_latency
+ * @{
+ *
+ * @file
+ * @brief       Input-to-photon latency histogram
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "led_matrix.h"
+#include "led_matrix_latency.h"
+#include "led_matrix_params.h"
+
+#define US_PER_FRAME    (1000000UL / LED_MATRIX_FPS)
+
+static led_matrix_latency_stats_t stats = { .min = UINT32_MAX };
+static uint32_t pending_seen_at;
+static bool pending;
+
+void led_matrix_latency_start(uint32_t seen_at)
+{
+    unsigned irq_state = irq_disable();
+    /* keep the oldest input, it has to wait the longest */
+    if (!pending) {
+        pending_seen_at = seen_at;
+        pending = true;
+    }
+    irq_restore(irq_state);
+}
+
+bool led_matrix_latency_take(uint32_t *seen_at)
+{
+    if (!pending) {
+        return false;
+    }
+
+    *seen_at = pending_seen_at;
+    pending = false;
+    return true;
+}
+
+void led_matrix_latency_record(uint32_t latency)
+{
+    unsigned bin = (latency + LED_MATRIX_SLOTS_PER_FRAME - 1) / LED_MATRIX_SLOTS_PER_FRAME;
+    if (bin >= CONFIG_LED_MATRIX_LATENCY_BINS) {
+        bin = CONFIG_LED_MATRIX_LATENCY_BINS - 1;
+    }
+
+    stats.bins[bin]++;
+    stats.numof++;
+    stats.sum += latency;
+    if (latency < stats.min) {
+        stats.min = latency;
+    }
+    if (latency > stats.max) {
+        stats.max = latency;
+    }
+}
+
+void led_matrix_latency_get(led_matrix_latency_stats_t *dest)
+{
+    unsigned irq_state = irq_disable();
+    *dest = stats;
+    irq_restore(irq_state);
+}
+
+void led_matrix_latency_reset(void)
+{
+    unsigned irq_state = irq_disable();
+    memset(&stats, 0, sizeof(stats));
+    stats.min = UINT32_MAX;
+    irq_restore(irq_state);
+}
+
+void led_matrix_latency_print(void)
+{
+    led_matrix_latency_stats_t s;
+    led_matrix_latency_get(&s);
+
+    printf("input-to-photon latency of %" PRIu32 " presses\n", s.numof);
+    if (s.numof == 0) {
+        return;
+    }
+
+    /* Only use the binned values, which do not depend on where within a
+     * frame the scan took place. This way the report of the native board
+     * matches the one of the hardware */
+    uint32_t frames_sum = 0;
+    unsigned first = CONFIG_LED_MATRIX_LATENCY_BINS;
+    unsigned last = 0;
+    for (unsigned i = 0; i < CONFIG_LED_MATRIX_LATENCY_BINS; i++) {
+        if (s.bins[i]) {
+            frames_sum += i * s.bins[i];
+            first = (i < first) ? i : first;
+            last = i;
+        }
+    }
+
+    uint32_t mean_centi = frames_sum * 100 / s.numof;
+    printf("frames: min %u, mean %" PRIu32 ".%02" PRIu32 ", max %u%s\n",
+           first, mean_centi / 100, mean_centi % 100, last,
+           (last == CONFIG_LED_MATRIX_LATENCY_BINS - 1) ? "+" : "");
+    printf("mean: %" PRIu32 " us\n", (uint32_t)(mean_centi * US_PER_FRAME / 100));
+
+    for (unsigned i = first; i <= last; i++) {
+        printf("%2u%s %6" PRIu32 " |", i,
+               (i == CONFIG_LED_MATRIX_LATENCY_BINS - 1) ? "+" : " ", s.bins[i]);
+        /* bar scaled to at most 32 characters */
+        uint32_t len = (s.bins[i] * 32 + s.numof - 1) / s.numof;
+        while (len--) {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_led_matrix_queue
+ * @{
+ *
+ * @file
+ * @brief       Render command queue and display thread
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+
+#include "atomic_utils.h"
+#include "irq.h"
+#include "led_matrix.h"
+#include "led_matrix_queue.h"
+#include "mutex.h"
+#include "thread.h"
+
+#define QUEUE_MASK  (CONFIG_LED_MATRIX_QUEUE_SIZE - 1)
+
+static_assert((CONFIG_LED_MATRIX_QUEUE_SIZE & QUEUE_MASK) == 0,
+              "CONFIG_LED_MATRIX_QUEUE_SIZE must be a power of two");
+static_assert(CONFIG_LED_MATRIX_QUEUE_SIZE <= 128,
+              "CONFIG_LED_MATRIX_QUEUE_SIZE too large for 8 bit indices");
+
+/* multiple producers (serialized by disabling IRQs), single consumer (the
+ * display thread) ring buffer */
+static led_matrix_cmd_t queue[CONFIG_LED_MATRIX_QUEUE_SIZE];
+static uint8_t queue_head;
+static uint8_t queue_tail;
+static uint32_t dropped;
+static bool executing;
+static char stack[CONFIG_LED_MATRIX_QUEUE_STACKSIZE];
+
+/* the mutexes are used as signals: data_signal is unlocked whenever
+ * commands were added, space_signal whenever a command was taken out,
+ * idle_signal when all commands have been executed, and switch_signal when
+ * the refresh ISR switched the frame buffers */
+static mutex_t data_signal = MUTEX_INIT_LOCKED;
+static mutex_t space_signal = MUTEX_INIT_LOCKED;
+static mutex_t idle_signal = MUTEX_INIT_LOCKED;
+#if !MODULE_LED_MATRIX_HEADLESS
+static mutex_t switch_signal = MUTEX_INIT_LOCKED;
+#endif
+
+static bool add(const led_matrix_cmd_t *cmds, unsigned numof)
+{
+    unsigned irq_state = irq_disable();
+    uint8_t head = queue_head;
+
+    if (CONFIG_LED_MATRIX_QUEUE_SIZE - (unsigned)(uint8_t)(head - queue_tail) < numof) {
+        irq_restore(irq_state);
+        return false;
+    }
+
+    for (unsigned i = 0; i < numof; i++) {
+        queue[(uint8_t)(head + i) & QUEUE_MASK] = cmds[i];
+    }
+    queue_head = head + numof;
+
+    irq_restore(irq_state);
+    return true;
+}
+
+static bool take(led_matrix_cmd_t *cmd)
+{
+    uint8_t tail = queue_tail;
+    if (atomic_load_u8(&queue_head) == tail) {
+        return false;
+    }
+
+    *cmd = queue[tail & QUEUE_MASK];
+    /* release the slot only after it has been read */
+    atomic_store_u8(&queue_tail, tail + 1);
+    return true;
+}
+
+int led_matrix_queue_submit(const led_matrix_cmd_t *cmds, unsigned numof)
+{
+    assert(numof <= CONFIG_LED_MATRIX_QUEUE_SIZE);
+
+    while (!add(cmds, numof)) {
+        if (irq_is_in()) {
+            dropped += numof;
+            return -EAGAIN;
+        }
+        mutex_lock(&space_signal);
+    }
+
+    mutex_unlock(&data_signal);
+    return 0;
+}
+
+void led_matrix_queue_flush(void)
+{
+    assert(!irq_is_in());
+
+    /* idle_signal may still be unlocked from an earlier idle phase */
+    while ((atomic_load_u8(&queue_head) != queue_tail) || executing) {
+        mutex_lock(&idle_signal);
+    }
+}
+
+uint32_t led_matrix_queue_dropped(void)
+{
+    return atomic_load_u32(&dropped);
+}
+
+void led_matrix_queue_switched(void)
+{
+#if !MODULE_LED_MATRIX_HEADLESS
+    mutex_unlock(&switch_signal);
+#endif
+}
+
+static void present(uint32_t frame)
+{
+#if MODULE_LED_MATRIX_HEADLESS
+    /* time only advances while waiting for it */
+    led_matrix_fb_switch(frame);
+#else
+    /* switch_signal may still be unlocked from an earlier switch */
+    led_matrix_fb_switch_request(frame);
+    while (!led_matrix_fb_switch_done(NULL)) {
+        mutex_lock(&switch_signal);
+    }
+#endif
+
+    /* commands modify the frame shown */
+    led_matrix_fb_copy_active();
+}
+
+static void execute(const led_matrix_cmd_t *cmd)
+{
+    switch (cmd->type) {
+    case LED_MATRIX_CMD_PIXEL:
+        led_matrix_fb_set(cmd->x, cmd->y, cmd->brightness);
+        break;
+    case LED_MATRIX_CMD_GLYPH:
+        led_matrix_glyph(cmd->glyph, cmd->x, cmd->y, cmd->brightness);
+        break;
+    case LED_MATRIX_CMD_TEXT:
+        led_matrix_text(cmd->font, cmd->text, cmd->len, cmd->x, cmd->y, cmd->brightness);
+        break;
+    case LED_MATRIX_CMD_CLEAR:
+        led_matrix_fb_clear();
+        break;
+    case LED_MATRIX_CMD_PRESENT:
+        present(cmd->frame);
+        break;
+    default:
+        assert(0);
+        break;
+    }
+}
+
+static void *_display(void *arg)
+{
+    (void)arg;
+    led_matrix_cmd_t cmd;
+
+    while (1) {
+        unsigned irq_state = irq_disable();
+        if (!take(&cmd)) {
+            executing = false;
+            irq_restore(irq_state);
+            mutex_unlock(&idle_signal);
+            mutex_lock(&data_signal);
+            continue;
+        }
+        executing = true;
+        irq_restore(irq_state);
+
+        mutex_unlock(&space_signal);
+        execute(&cmd);
+    }
+
+    return NULL;
+}
+
+void led_matrix_queue_init(void)
+{
+    thread_create(stack, sizeof(stack), CONFIG_LED_MATRIX_QUEUE_PRIO, 0, _display,
+                  NULL, "led_matrix");
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_effects
+ * @{
+ *
+ * @file
+ * @brief       Fire effect
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "led_matrix.h"
+#include "led_matrix_effects.h"
+#include "led_matrix_effects_internal.h"
+#include "led_matrix_params.h"
+
+#define H   LED_MATRIX_HEIGHT
+
+static void init(led_matrix_effects_state_t *state, uint32_t seed)
+{
+    led_matrix_effects_fire_t *fire = &state->fire;
+
+    memset(fire->heat, 0, sizeof(fire->heat));
+    fire->seed = seed ? seed : 1;
+}
+
+static void render(led_matrix_effects_state_t *state, uint32_t t)
+{
+    led_matrix_effects_fire_t *fire = &state->fire;
+    uint8_t *heat = fire->heat;
+    uint32_t rnd = fire->seed;
+
+    /* the heat rises: every pixel gets the average of the three pixels
+     * below it and the one below those, minus some random cooling. Going
+     * row by row from the top, the rows below are still the ones of the
+     * previous frame */
+    for (unsigned y = 0; y < H - 1; y++) {
+        for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+            unsigned l = ((x == 0) ? LED_MATRIX_WIDTH - 1 : x - 1) * H + y + 1;
+            unsigned c = x * H + y + 1;
+            unsigned r = ((x == LED_MATRIX_WIDTH - 1) ? 0 : x + 1) * H + y + 1;
+            unsigned below = (y + 2 < H) ? c + 1 : c;
+            unsigned avg = (heat[l] + heat[c] + heat[r] + heat[below]) >> 2;
+
+            /* a random number yields the cooling of eight pixels */
+            if ((x & 0x7) == 0) {
+                rnd = led_matrix_effects_rand(rnd);
+            }
+            unsigned cool = 14 + ((rnd >> ((x & 0x7) * 4)) & 0xf);
+            heat[x * H + y] = (avg > cool) ? avg - cool : 0;
+        }
+    }
+
+    /* embers glowing in the bottom row */
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        heat[x * H + H - 1] = 96 + ((led_matrix_effects_noise(x * 80, t * 20) * 160) >> 8);
+    }
+
+    fire->seed = rnd;
+
+    uint8_t *fb = led_matrix_fb_scratch();
+    for (unsigned pos = 0; pos < LED_MATRIX_LED_NUMOF; pos++) {
+        led_matrix_effects_put(fb, pos, heat[pos] >> 4);
+    }
+}
+
+const led_matrix_effect_t led_matrix_effect_fire = {
+    .name = "Fire",
+    .init = init,
+    .render = render,
+};
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_led_matrix_effects  Procedural Effects for the LED Matrix
+ * @ingroup     sys
+ *
+ * This module provides animated full screen effects for ambient and attract
+ * mode visuals: plasma, fire, a starfield, and ripples.
+ *
+ * The Cortex-M0+ has neither an FPU nor a hardware divider, so all math is
+ * done in fixed point with lookup tables: A sine table of a quarter wave
+ * (@ref led_matrix_effects_sin), value noise from a hashed lattice with
+ * smoothstep interpolation (@ref led_matrix_effects_noise), and a table of
+ * reciprocals for the perspective projection of the starfield.
+ *
+ * Every effect renders a frame into the scratch frame buffer of
+ * @ref drivers_led_matrix, the full screen effects fill it directly in the
+ * order of its memory layout (see @ref led_matrix_fb_scratch). The caller
+ * then shows the frame with @ref led_matrix_fb_switch as usual:
+ *
+ * ```C
+ * led_matrix_effects_state_t state;
+ * const led_matrix_effect_t *effect = &led_matrix_effect_fire;
+ * uint32_t frame = led_matrix_frame_number();
+ *
+ * if (effect->init) {
+ *     effect->init(&state, seed);
+ * }
+ * while (1) {
+ *     effect->render(&state, frame);
+ *     frame = led_matrix_fb_switch(frame) + 1;
+ * }
+ * ```
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `led_matrix_effects` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_EFFECTS_H
+#define LED_MATRIX_EFFECTS_H
+
+#include <stdint.h>
+
+#include "led_matrix.h"
+#include "led_matrix_params.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of stars in the starfield
+ */
+#ifndef CONFIG_LED_MATRIX_EFFECTS_STARS
+#  define CONFIG_LED_MATRIX_EFFECTS_STARS   12
+#endif
+
+/**
+ * @brief   Get the sine of the given angle
+ *
+ * @param[in]   angle   The angle in 1/256 of a full turn
+ *
+ * @return  The sine scaled to -127 ... 127
+ */
+int8_t led_matrix_effects_sin(uint8_t angle);
+
+/**
+ * @brief   Get the cosine of the given angle
+ *
+ * @param[in]   angle   The angle in 1/256 of a full turn
+ *
+ * @return  The cosine scaled to -127 ... 127
+ */
+static inline int8_t led_matrix_effects_cos(uint8_t angle)
+{
+    return led_matrix_effects_sin(angle + 64);
+}
+
+/**
+ * @brief   Get smooth 2D value noise at the given position
+ *
+ * @param[in]   x       X-coordinate in 1/256 of the lattice spacing
+ * @param[in]   y       Y-coordinate in 1/256 of the lattice spacing
+ *
+ * @return  The noise value in 0 ... 255, changing smoothly with @p x and
+ *          @p y
+ */
+uint8_t led_matrix_effects_noise(uint32_t x, uint32_t y);
+
+/**
+ * @brief   State of the fire effect
+ */
+typedef struct {
+    uint8_t heat[LED_MATRIX_LED_NUMOF];     /**< Heat of every pixel, in frame buffer order */
+    uint32_t seed;                          /**< PRNG state for the cooling */
+} led_matrix_effects_fire_t;
+
+/**
+ * @brief   A star of the starfield
+ */
+typedef struct {
+    int8_t x;       /**< X-coordinate relative to the center of the view */
+    int8_t y;       /**< Y-coordinate relative to the center of the view */
+    uint8_t z;      /**< Distance to the viewer */
+    uint8_t speed;  /**< Distance travelled towards the viewer per frame */
+} led_matrix_effects_star_t;
+
+/**
+ * @brief   State of the starfield effect
+ */
+typedef struct {
+    led_matrix_effects_star_t stars[CONFIG_LED_MATRIX_EFFECTS_STARS];   /**< The stars */
+    uint32_t seed;                          /**< PRNG state for placing new stars */
+} led_matrix_effects_starfield_t;
+
+/**
+ * @brief   State of the ripple effect
+ */
+typedef struct {
+    uint8_t dist[LED_MATRIX_LED_NUMOF];     /**< Distance of every pixel to the center in 1/16 pixel */
+} led_matrix_effects_ripple_t;
+
+/**
+ * @brief   State of any effect
+ *
+ * Only one effect is shown at a time, so they can share the memory.
+ */
+typedef union {
+    led_matrix_effects_fire_t fire;             /**< State of the fire effect */
+    led_matrix_effects_starfield_t starfield;   /**< State of the starfield effect */
+    led_matrix_effects_ripple_t ripple;         /**< State of the ripple effect */
+} led_matrix_effects_state_t;
+
+/**
+ * @brief   An effect
+ */
+typedef struct {
+    const char *name;   /**< Name of the effect */
+    /**
+     * @brief   Prepare the state of the effect
+     *
+     * @param[out]  state   The state to initialize
+     * @param[in]   seed    Seed for effects with random elements
+     *
+     * `NULL` for effects without state.
+     */
+    void (*init)(led_matrix_effects_state_t *state, uint32_t seed);
+    /**
+     * @brief   Render the next frame into the scratch frame buffer
+     *
+     * @param[in,out]   state   The state of the effect
+     * @param[in]       t       Time in frames, e.g. the frame number
+     *
+     * Effects with state advance it by one frame per call, @p t only drives
+     * the animation of the stateless ones.
+     */
+    void (*render)(led_matrix_effects_state_t *state, uint32_t t);
+} led_matrix_effect_t;
+
+/**
+ * @brief   Interfering sine waves
+ */
+extern const led_matrix_effect_t led_matrix_effect_plasma;
+
+/**
+ * @brief   Flames rising from a bed of embers driven by noise
+ */
+extern const led_matrix_effect_t led_matrix_effect_fire;
+
+/**
+ * @brief   Flight through a field of stars
+ */
+extern const led_matrix_effect_t led_matrix_effect_starfield;
+
+/**
+ * @brief   Circular waves around the center
+ */
+extern const led_matrix_effect_t led_matrix_effect_ripple;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_EFFECTS_H */
+/** @} */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_effects
+ * @{
+ *
+ * @file
+ * @brief       Fixed-point sine and noise
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "led_matrix_effects.h"
+
+/* sin(i / 256 * 2 pi) * 127 for the first quarter wave, including 90 deg */
+static const int8_t sin_quarter[65] = {
+      0,   3,   6,   9,  12,  16,  19,  22,  25,  28,  31,  34,  37,  40,  43,  46,
+     49,  51,  54,  57,  60,  63,  65,  68,  71,  73,  76,  78,  81,  83,  85,  88,
+     90,  92,  94,  96,  98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+    117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+    127,
+};
+
+int8_t led_matrix_effects_sin(uint8_t angle)
+{
+    unsigned idx = angle & 0x3f;
+
+    switch (angle >> 6) {
+    case 0:
+        return sin_quarter[idx];
+    case 1:
+        return sin_quarter[64 - idx];
+    case 2:
+        return -sin_quarter[idx];
+    default:
+        return -sin_quarter[64 - idx];
+    }
+}
+
+/* pseudo random value of a lattice point */
+static int lattice(uint32_t x, uint32_t y)
+{
+    uint32_t h = (x * 0x27d4eb2dU) ^ (y * 0x165667b1U);
+    h ^= h >> 15;
+    h *= 0x2c1b3c6dU;
+    h ^= h >> 12;
+    return h >> 24;
+}
+
+static int lerp(int a, int b, unsigned s)
+{
+    return a + (((b - a) * (int)s) >> 8);
+}
+
+uint8_t led_matrix_effects_noise(uint32_t x, uint32_t y)
+{
+    uint32_t ix = x >> 8;
+    uint32_t iy = y >> 8;
+    uint32_t fx = x & 0xff;
+    uint32_t fy = y & 0xff;
+
+    /* smoothstep 3 f^2 - 2 f^3, so that the lattice does not show */
+    unsigned sx = (fx * fx * (768 - 2 * fx)) >> 16;
+    unsigned sy = (fy * fy * (768 - 2 * fy)) >> 16;
+
+    int top = lerp(lattice(ix, iy), lattice(ix + 1, iy), sx);
+    int bottom = lerp(lattice(ix, iy + 1), lattice(ix + 1, iy + 1), sx);
+    return lerp(top, bottom, sy);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_effects
+ * @{
+ *
+ * @file
+ * @brief       Helpers shared by the effects
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_EFFECTS_INTERNAL_H
+#define LED_MATRIX_EFFECTS_INTERNAL_H
+
+#include <stdint.h>
+
+#include "led_matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Write the brightness of the next pixel into the frame buffer
+ *
+ * @param[out]  fb          The scratch frame buffer
+ * @param[in]   pos         Index of the pixel, pixels must be written in
+ *                          order starting from 0
+ * @param[in]   brightness  The brightness (0 to @ref LED_MATRIX_BRIGHTNESS_MAX)
+ *
+ * The first pixel of a byte overwrites the whole byte, so the frame buffer
+ * needs no clearing.
+ */
+static inline void led_matrix_effects_put(uint8_t *fb, unsigned pos, unsigned brightness)
+{
+    if (pos & 0x1) {
+        fb[pos >> 1] |= brightness << 4;
+    }
+    else {
+        fb[pos >> 1] = brightness;
+    }
+}
+
+/**
+ * @brief   Get the next PRNG sequence value (xorshift32)
+ */
+static inline uint32_t led_matrix_effects_rand(uint32_t x)
+{
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+/**
+ * @brief   Map a value of -128 ... 127 to a brightness
+ */
+static inline unsigned led_matrix_effects_level(int value)
+{
+    return (unsigned)(value + 128) >> 4;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_EFFECTS_INTERNAL_H */
+/** @} */
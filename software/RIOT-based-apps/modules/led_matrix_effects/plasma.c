@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_effects
+ * @{
+ *
+ * @file
+ * @brief       Plasma effect
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "led_matrix.h"
+#include "led_matrix_effects.h"
+#include "led_matrix_effects_internal.h"
+#include "led_matrix_params.h"
+
+static void render(led_matrix_effects_state_t *state, uint32_t t)
+{
+    (void)state;
+    uint8_t *fb = led_matrix_fb_scratch();
+    int8_t rows[LED_MATRIX_HEIGHT];
+    unsigned pos = 0;
+
+    /* the waves along a single axis are the same for every column / row */
+    for (unsigned y = 0; y < LED_MATRIX_HEIGHT; y++) {
+        rows[y] = led_matrix_effects_sin(y * 28 + t * 3);
+    }
+
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        int col = led_matrix_effects_sin(x * 24 + t * 2);
+        for (unsigned y = 0; y < LED_MATRIX_HEIGHT; y++) {
+            int sum = col + rows[y] + led_matrix_effects_sin((x + y) * 16 - t);
+            /* fold the sum of the waves through another sine as palette */
+            int value = led_matrix_effects_sin((sum >> 1) + t);
+            led_matrix_effects_put(fb, pos++, led_matrix_effects_level(value));
+        }
+    }
+}
+
+const led_matrix_effect_t led_matrix_effect_plasma = {
+    .name = "Plasma",
+    .init = NULL,
+    .render = render,
+};
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_effects
+ * @{
+ *
+ * @file
+ * @brief       Ripple effect
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "led_matrix.h"
+#include "led_matrix_effects.h"
+#include "led_matrix_effects_internal.h"
+#include "led_matrix_params.h"
+
+static unsigned isqrt(uint32_t n)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > n) {
+        bit >>= 2;
+    }
+
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+static void init(led_matrix_effects_state_t *state, uint32_t seed)
+{
+    (void)seed;
+    led_matrix_effects_ripple_t *ripple = &state->ripple;
+    unsigned pos = 0;
+
+    /* the square roots are too expensive to take every frame */
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        for (unsigned y = 0; y < LED_MATRIX_HEIGHT; y++) {
+            /* in half pixels, so that the center may be between pixels */
+            int dx = 2 * (int)x - (int)(LED_MATRIX_WIDTH - 1);
+            int dy = 2 * (int)y - (int)(LED_MATRIX_HEIGHT - 1);
+            ripple->dist[pos++] = isqrt((uint32_t)(dx * dx + dy * dy) << 6);
+        }
+    }
+}
+
+static void render(led_matrix_effects_state_t *state, uint32_t t)
+{
+    const led_matrix_effects_ripple_t *ripple = &state->ripple;
+    uint8_t *fb = led_matrix_fb_scratch();
+
+    for (unsigned pos = 0; pos < LED_MATRIX_LED_NUMOF; pos++) {
+        unsigned dist = ripple->dist[pos];
+        /* waves of 4 pixels length moving outwards, fading with the distance */
+        int value = led_matrix_effects_sin(dist * 4 - t * 6);
+        unsigned brightness = ((unsigned)(value + 128) * (256 - dist)) >> 12;
+        led_matrix_effects_put(fb, pos, brightness);
+    }
+}
+
+const led_matrix_effect_t led_matrix_effect_ripple = {
+    .name = "Ripple",
+    .init = init,
+    .render = render,
+};
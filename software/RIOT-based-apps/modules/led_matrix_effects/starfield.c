@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_effects
+ * @{
+ *
+ * @file
+ * @brief       Starfield effect
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "led_matrix.h"
+#include "led_matrix_effects.h"
+#include "led_matrix_effects_internal.h"
+#include "led_matrix_params.h"
+
+/* stars closer than this are replaced */
+#define Z_MIN       16
+#define Z_MAX       255
+/* center of the screen in 1/256 pixel */
+#define CENTER_X    ((LED_MATRIX_WIDTH - 1) * 128)
+#define CENTER_Y    ((LED_MATRIX_HEIGHT - 1) * 128)
+
+/* 65536 / z for z in the middle of the ranges 4 i ... 4 i + 3, as there is
+ * no hardware divider */
+static const uint16_t recip[64] = {
+    32768, 10922,  6553,  4681,  3640,  2978,  2520,  2184,
+     1927,  1724,  1560,  1424,  1310,  1213,  1129,  1057,
+      992,   936,   885,   840,   799,   762,   728,   697,
+      668,   642,   618,   595,   574,   555,   537,   520,
+      504,   489,   474,   461,   448,   436,   425,   414,
+      404,   394,   385,   376,   368,   360,   352,   344,
+      337,   330,   324,   318,   312,   306,   300,   295,
+      289,   284,   280,   275,   270,   266,   262,   258,
+};
+
+static void spawn(led_matrix_effects_star_t *star, uint32_t *seed, uint8_t z)
+{
+    uint32_t rnd = led_matrix_effects_rand(*seed);
+
+    star->x = (int8_t)rnd >> 1;
+    star->y = (int8_t)(rnd >> 8) >> 1;
+    star->z = z;
+    star->speed = 1 + ((rnd >> 16) & 0x3);
+    *seed = rnd;
+}
+
+static void init(led_matrix_effects_state_t *state, uint32_t seed)
+{
+    led_matrix_effects_starfield_t *field = &state->starfield;
+
+    field->seed = seed ? seed : 1;
+    for (unsigned i = 0; i < CONFIG_LED_MATRIX_EFFECTS_STARS; i++) {
+        /* spread over all distances, so that they do not arrive at once */
+        uint8_t z = Z_MIN + (((field->seed >> 24) * (Z_MAX - Z_MIN)) >> 8);
+        spawn(&field->stars[i], &field->seed, z);
+    }
+}
+
+static void render(led_matrix_effects_state_t *state, uint32_t t)
+{
+    (void)t;
+    led_matrix_effects_starfield_t *field = &state->starfield;
+
+    led_matrix_fb_clear();
+
+    for (unsigned i = 0; i < CONFIG_LED_MATRIX_EFFECTS_STARS; i++) {
+        led_matrix_effects_star_t *star = &field->stars[i];
+
+        if (star->z < Z_MIN + star->speed) {
+            spawn(star, &field->seed, Z_MAX);
+        }
+        else {
+            star->z -= star->speed;
+        }
+
+        /* perspective projection, in 1/256 pixel */
+        int r = recip[star->z >> 2];
+        int x = (CENTER_X + ((star->x * r) >> 6) + 128) >> 8;
+        int y = (CENTER_Y + ((star->y * r) >> 6) + 128) >> 8;
+
+        if (((unsigned)x >= LED_MATRIX_WIDTH) || ((unsigned)y >= LED_MATRIX_HEIGHT)) {
+            spawn(star, &field->seed, Z_MAX);
+            continue;
+        }
+
+        /* closer stars are brighter */
+        unsigned brightness = (Z_MAX + Z_MIN + 1 - star->z) >> 4;
+        if (brightness > LED_MATRIX_BRIGHTNESS_MAX) {
+            brightness = LED_MATRIX_BRIGHTNESS_MAX;
+        }
+        led_matrix_fb_set(x, y, brightness);
+    }
+}
+
+const led_matrix_effect_t led_matrix_effect_starfield = {
+    .name = "Starfield",
+    .init = init,
+    .render = render,
+};
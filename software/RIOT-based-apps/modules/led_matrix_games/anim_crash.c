@@ -0,0 +1,48 @@
+/* This file is auto generated using anim2c.py */
+#include <stdint.h>
+#include "led_matrix.h"
+
+static const uint8_t _led_matrix_games_anim_crash[] = {
+    0x03, 0x00, 0x02, 0xaf, 0x04, 0xcf, 0x04, 0xaf,
+    0x06, 0x8f, 0x39, 0x03, 0x00, 0x02, 0x8c, 0x8d,
+    0x8c, 0x04, 0x81, 0x8d, 0x8c, 0x8d, 0x81, 0x04,
+    0x8c, 0x8d, 0x8c, 0x06, 0x81, 0x39, 0x03, 0x00,
+    0x01, 0x98, 0x89, 0x98, 0x03, 0x8a, 0xa9, 0x8a,
+    0x03, 0x98, 0x89, 0x98, 0x03, 0x82, 0x88, 0x8a,
+    0x88, 0x82, 0x37, 0x03, 0x00, 0x00, 0x97, 0x02,
+    0x97, 0x01, 0x88, 0x85, 0x00, 0x86, 0x00, 0x85,
+    0x88, 0x01, 0x97, 0x02, 0x97, 0x01, 0x83, 0x8a,
+    0x87, 0x85, 0x87, 0x8a, 0x83, 0x02, 0x83, 0x87,
+    0x88, 0x87, 0x83, 0x2e, 0x03, 0x00, 0x96, 0x04,
+    0x96, 0x87, 0x85, 0x01, 0x83, 0x01, 0x85, 0x87,
+    0x96, 0x04, 0x96, 0x83, 0x8a, 0x84, 0x02, 0x84,
+    0x8a, 0x83, 0x00, 0x85, 0x8a, 0x86, 0x85, 0x86,
+    0x8a, 0x85, 0x02, 0x83, 0x86, 0x87, 0x86, 0x83,
+    0x25, 0x03, 0x00, 0x86, 0x06, 0x86, 0x85, 0x06,
+    0x85, 0x86, 0x06, 0x86, 0x89, 0x82, 0x04, 0x82,
+    0x89, 0x85, 0x87, 0x82, 0x02, 0x82, 0x87, 0x85,
+    0x00, 0x85, 0x89, 0x86, 0x85, 0x86, 0x89, 0x85,
+    0x02, 0x82, 0x84, 0x85, 0x84, 0x82, 0x1c, 0x03,
+    0x00, 0x1a, 0x82, 0x06, 0x82, 0x85, 0x06, 0x85,
+    0x86, 0x85, 0x82, 0x02, 0x82, 0x85, 0x86, 0x81,
+    0x85, 0x87, 0x86, 0x85, 0x86, 0x87, 0x85, 0x81,
+    0x01, 0x82, 0x83, 0x84, 0x83, 0x82, 0x13, 0x03,
+    0x00, 0x2c, 0x83, 0x06, 0x83, 0x86, 0x84, 0x81,
+    0x02, 0x81, 0x84, 0x86, 0x82, 0x84, 0x86, 0xa5,
+    0x86, 0x84, 0x82, 0x01, 0x81, 0x82, 0x83, 0x82,
+    0x81, 0x0a, 0x03, 0x00, 0x35, 0x82, 0x06, 0x82,
+    0x85, 0x83, 0x81, 0x02, 0x81, 0x83, 0x85, 0x81,
+    0x83, 0x85, 0xa4, 0x85, 0x83, 0x81, 0x01, 0x91,
+    0x82, 0x91, 0x01, 0x03, 0x00, 0x3e, 0x81, 0x06,
+    0x81, 0x84, 0x82, 0x91, 0x00, 0x91, 0x82, 0x84,
+    0x81, 0x82, 0x83, 0x84, 0x83, 0x84, 0x83, 0x82,
+    0x81, 0x03, 0x00, 0x47, 0x81, 0x06, 0x81, 0x92,
+    0x91, 0x00, 0x91, 0x92, 0x03, 0x00, 0x59,
+};
+
+const led_matrix_anim_t led_matrix_games_anim_crash = {
+    .data = _led_matrix_games_anim_crash,
+    .frames_numof = 12,
+};
+
+/* animation data: 279 bytes, uncompressed: 564 bytes */
@@ -0,0 +1,135 @@
+/* This file is auto generated using assets2c.py */
+#include <stdint.h>
+#include "bitmap_fonts.h"
+
+static const uint8_t _led_matrix_games_msg_flappy_led_instructions[] = {
+    0x7f, 0x09, 0x06, 0x00, 0x78, 0x04, 0x04, 0x00,
+    0x38, 0x54, 0x48, 0x00, 0x48, 0x54, 0x24, 0x00,
+    0x48, 0x54, 0x24, 0x00, 0x00, 0x00, 0x20, 0x54,
+    0x78, 0x00, 0x7c, 0x04, 0x78, 0x00, 0x1c, 0xa0,
+    0x7c, 0x00, 0x00, 0x00, 0x7f, 0x44, 0x38, 0x00,
+    0x3c, 0x40, 0x7c, 0x00, 0x04, 0x3f, 0x44, 0x00,
+    0x04, 0x3f, 0x44, 0x00, 0x38, 0x44, 0x38, 0x00,
+    0x7c, 0x04, 0x78, 0x00, 0x00, 0x00, 0x04, 0x3f,
+    0x44, 0x00, 0x38, 0x44, 0x38, 0x00, 0x00, 0x00,
+    0x18, 0xa4, 0x7c, 0x00, 0x20, 0x54, 0x78, 0x00,
+    0x7a, 0x00, 0x7c, 0x04, 0x78, 0x00, 0x00, 0x00,
+    0x20, 0x54, 0x78, 0x00, 0x7f, 0x00, 0x04, 0x3f,
+    0x44, 0x00, 0x7a, 0x00, 0x04, 0x3f, 0x44, 0x00,
+    0x3c, 0x40, 0x7c, 0x00, 0x38, 0x44, 0x7f, 0x00,
+    0x38, 0x54, 0x48, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x7e, 0x09, 0x7e, 0x00, 0x1c, 0x60, 0x1c, 0x00,
+    0x38, 0x44, 0x38, 0x00, 0x7a, 0x00, 0x38, 0x44,
+    0x7f, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x00,
+    0x78, 0x04, 0x04, 0x20, 0x54, 0x78, 0x00, 0x48,
+    0x54, 0x24, 0x00, 0x7f, 0x04, 0x78, 0x00, 0x7a,
+    0x00, 0x7c, 0x04, 0x78, 0x00, 0x18, 0xa4, 0x7c,
+    0x00, 0x00, 0x00, 0x7a, 0x00, 0x7c, 0x04, 0x78,
+    0x00, 0x04, 0x3f, 0x44, 0x00, 0x38, 0x44, 0x38,
+    0x00, 0x00, 0x00, 0x38, 0x44, 0x38, 0x00, 0x7f,
+    0x44, 0x38, 0x00, 0x48, 0x54, 0x24, 0x00, 0x04,
+    0x3f, 0x44, 0x00, 0x20, 0x54, 0x78, 0x00, 0x38,
+    0x44, 0x44, 0x00, 0x7f, 0x00, 0x38, 0x54, 0x48,
+    0x00, 0x48, 0x54, 0x24, 0x00, 0x40,
+};
+
+const bitmap_glyph_t led_matrix_games_msg_flappy_led_instructions = {
+    .data = _led_matrix_games_msg_flappy_led_instructions,
+    .width = 222,
+    .height = 8,
+    .bytes_per_column = 1,
+};
+
+static const uint8_t _led_matrix_games_msg_flappy_led_lost[] = {
+    0x07, 0x78, 0x07, 0x00, 0x38, 0x44, 0x38, 0x00,
+    0x3c, 0x40, 0x7c, 0x00, 0x00, 0x00, 0x7f, 0x00,
+    0x38, 0x44, 0x38, 0x00, 0x48, 0x54, 0x24, 0x00,
+    0x04, 0x3f, 0x44, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x07, 0x78, 0x07, 0x00, 0x38, 0x44, 0x38, 0x00,
+    0x3c, 0x40, 0x7c, 0x00, 0x78, 0x04, 0x04, 0x00,
+    0x00, 0x00, 0x48, 0x54, 0x24, 0x00, 0x38, 0x44,
+    0x44, 0x00, 0x38, 0x44, 0x38, 0x00, 0x78, 0x04,
+    0x04, 0x00, 0x38, 0x54, 0x48, 0x00, 0x14,
+};
+
+const bitmap_glyph_t led_matrix_games_msg_flappy_led_lost = {
+    .data = _led_matrix_games_msg_flappy_led_lost,
+    .width = 71,
+    .height = 8,
+    .bytes_per_column = 1,
+};
+
+static const uint8_t _led_matrix_games_msg_ledmon_says_instructions[] = {
+    0x7e, 0x01, 0x0e, 0x01, 0x7e, 0x00, 0x38, 0x54,
+    0x48, 0x00, 0x7c, 0x04, 0x78, 0x04, 0x78, 0x00,
+    0x38, 0x44, 0x38, 0x00, 0x78, 0x04, 0x04, 0x00,
+    0x7a, 0x00, 0x64, 0x54, 0x4c, 0x00, 0x38, 0x54,
+    0x48, 0x00, 0x00, 0x00, 0x04, 0x3f, 0x44, 0x00,
+    0x7f, 0x04, 0x78, 0x00, 0x38, 0x54, 0x48, 0x00,
+    0x00, 0x00, 0x7f, 0x44, 0x38, 0x00, 0x3c, 0x40,
+    0x7c, 0x00, 0x04, 0x3f, 0x44, 0x00, 0x04, 0x3f,
+    0x44, 0x00, 0x38, 0x44, 0x38, 0x00, 0x7c, 0x04,
+    0x78, 0x00, 0x00, 0x00, 0x48, 0x54, 0x24, 0x00,
+    0x38, 0x54, 0x48, 0x00, 0x18, 0x24, 0xfc, 0x00,
+    0x3c, 0x40, 0x7c, 0x00, 0x38, 0x54, 0x48, 0x00,
+    0x7c, 0x04, 0x78, 0x00, 0x38, 0x44, 0x44, 0x00,
+    0x38, 0x54, 0x48, 0x00, 0x00, 0x00, 0x48, 0x54,
+    0x24, 0x00, 0x7f, 0x04, 0x78, 0x00, 0x38, 0x44,
+    0x38, 0x00, 0x3c, 0x40, 0x3c, 0x40, 0x3c, 0x00,
+    0x7c, 0x04, 0x78, 0x00, 0x00, 0x00, 0x20, 0x54,
+    0x78, 0x00, 0x7c, 0x04, 0x78, 0x00, 0x38, 0x44,
+    0x7f, 0x00, 0x00, 0x00, 0x38, 0x54, 0x48, 0x00,
+    0x7c, 0x04, 0x78, 0x00, 0x04, 0x3f, 0x44, 0x00,
+    0x38, 0x54, 0x48, 0x00, 0x78, 0x04, 0x04, 0x00,
+    0x00, 0x00, 0x7a, 0x00, 0x04, 0x3f, 0x44, 0x00,
+    0x40, 0x00, 0x00, 0x00, 0x7f, 0x09, 0x06, 0x00,
+    0x78, 0x04, 0x04, 0x00, 0x38, 0x54, 0x48, 0x00,
+    0x48, 0x54, 0x24, 0x00, 0x48, 0x54, 0x24, 0x00,
+    0x00, 0x00, 0x20, 0x54, 0x78, 0x00, 0x7c, 0x04,
+    0x78, 0x00, 0x1c, 0xa0, 0x7c, 0x00, 0x00, 0x00,
+    0x7f, 0x44, 0x38, 0x00, 0x3c, 0x40, 0x7c, 0x00,
+    0x04, 0x3f, 0x44, 0x00, 0x04, 0x3f, 0x44, 0x00,
+    0x38, 0x44, 0x38, 0x00, 0x7c, 0x04, 0x78, 0x00,
+    0x00, 0x00, 0x04, 0x3f, 0x44, 0x00, 0x38, 0x44,
+    0x38, 0x00, 0x00, 0x00, 0x48, 0x54, 0x24, 0x00,
+    0x04, 0x3f, 0x44, 0x00, 0x20, 0x54, 0x78, 0x00,
+    0x78, 0x04, 0x04, 0x00, 0x04, 0x3f, 0x44,
+};
+
+const bitmap_glyph_t led_matrix_games_msg_ledmon_says_instructions = {
+    .data = _led_matrix_games_msg_ledmon_says_instructions,
+    .width = 271,
+    .height = 8,
+    .bytes_per_column = 1,
+};
+
+static const uint8_t _led_matrix_games_msg_you_lost[] = {
+    0x07, 0x78, 0x07, 0x00, 0x38, 0x44, 0x38, 0x00,
+    0x3c, 0x40, 0x7c, 0x00, 0x00, 0x00, 0x7f, 0x00,
+    0x38, 0x44, 0x38, 0x00, 0x48, 0x54, 0x24, 0x00,
+    0x04, 0x3f, 0x44,
+};
+
+const bitmap_glyph_t led_matrix_games_msg_you_lost = {
+    .data = _led_matrix_games_msg_you_lost,
+    .width = 27,
+    .height = 8,
+    .bytes_per_column = 1,
+};
+
+static const uint8_t _led_matrix_games_msg_your_score[] = {
+    0x07, 0x78, 0x07, 0x00, 0x38, 0x44, 0x38, 0x00,
+    0x3c, 0x40, 0x7c, 0x00, 0x78, 0x04, 0x04, 0x00,
+    0x00, 0x00, 0x48, 0x54, 0x24, 0x00, 0x38, 0x44,
+    0x44, 0x00, 0x38, 0x44, 0x38, 0x00, 0x78, 0x04,
+    0x04, 0x00, 0x38, 0x54, 0x48, 0x00, 0x14,
+};
+
+const bitmap_glyph_t led_matrix_games_msg_your_score = {
+    .data = _led_matrix_games_msg_your_score,
+    .width = 39,
+    .height = 8,
+    .bytes_per_column = 1,
+};
+
+/* asset data: 630 bytes */
@@ -1,173 +1,179 @@
-#include <assert.h>
 #include <stdbool.h>
 #include <string.h>
 
 #include "board.h"
 #include "button_matrix.h"
-#include "compiler_hints.h"
+#include "button_matrix_events.h"
+#include "button_matrix_params.h"
 #include "fmt.h"
 #include "led_matrix.h"
 #include "led_matrix_params.h"
 #include "led_matrix_games.h"
+#include "led_matrix_games_assets.h"
+#include "led_matrix_timeline.h"
+
+#if MODULE_FLASH_KV
+#include "flash_kv.h"
+#endif
 
 #define BLINK_HALF_PERIOD   5
 #define BLINKS_PER_STEP     1
+#define STEP_TICKS          (2 * BLINK_HALF_PERIOD * BLINKS_PER_STEP)
+#define FRAMES_PER_TICK     2       /**< 30 ticks per second */
+#define CATCH_UP_MAX        4
+#define CRASH_BLINKS        10
+#define CRASH_BLINK_FRAMES  12      /**< Period of the blinking after a crash */
+/* bit n of a tile is the row n - 1 relative to the screen at y_offset 0, so
+ * that the rows repeated above and below the tile are solid */
+#define TILE_YSHIFT         1
 
 static struct flappy_led_game_data * const data = &led_matrix_games_data.flappy_led;
 
-static struct flappy_led_obstacle *obstacle(uint8_t pos)
+static const led_matrix_bitboard_t flappy = {
+    .cols = { [1] = 1U << (LED_MATRIX_HEIGHT / 2) },
+};
+
+static uint16_t obstacle_tile(uint8_t gap_top, uint8_t gap_size)
 {
-    return &data->obstacles[(data->obstacles_pos + pos) & (ARRAY_SIZE(data->obstacles) - 1)];
+    return ~(((1U << gap_size) - 1) << (gap_top + TILE_YSHIFT));
 }
 
-static void draw_obstacles(void)
+static uint16_t gen_column(void *arg, uint32_t x)
 {
-    int x = data->first_obstacle_x;
+    (void)arg;
 
-    for (uint8_t i = 0; i < data->obstacles_numof; i++) {
-        struct flappy_led_obstacle *o = obstacle(i);
-
-        for (int y = 0; y < o->gap_top - data->y_offset; y++) {
-            led_matrix_fb_set(x, y, LED_MATRIX_BRIGHTNESS_MAX);
-        }
+    if (x != data->next_obstacle_x) {
+        return 0;
+    }
 
-        for (int y = o->gap_top + o->gap_size - data->y_offset; y < (int)LED_MATRIX_HEIGHT; y++) {
-            led_matrix_fb_set(x, y, LED_MATRIX_BRIGHTNESS_MAX);
+    /* the first obstacles come closer together quickly, then every fourth
+     * obstacle passed a bit more */
+    uint32_t n = data->obstacles_numof++;
+    if (n < 8) {
+        if ((n & 0x3) == 0x3) {
+            data->new_obstacle_distance--;
         }
-
-        x += (int)o->distance;
     }
-}
-
-static void spawn_abstacle(void)
-{
-    if (data->obstacles_numof >= ARRAY_SIZE(data->obstacles)) {
-        return;
+    else if ((((n - 8) & 0x3) == 0x0) && (data->new_obstacle_distance > 3)) {
+        data->new_obstacle_distance--;
     }
+    data->next_obstacle_x += data->new_obstacle_distance;
 
-    struct flappy_led_obstacle *o = obstacle(data->obstacles_numof);
+    uint8_t gap_top, gap_size;
     do {
         data->seed = xorshift32(data->seed);
-        o->gap_size = data->obstacle_min_gap + (data->seed & 0x3);
-        o->gap_top = (data->seed >> 2) & 0x7;
-    } while (o->gap_top + o->gap_size + 1U >= LED_MATRIX_HEIGHT);
+        gap_size = data->obstacle_min_gap + (data->seed & 0x3);
+        gap_top = (data->seed >> 2) & 0x7;
+    } while (gap_top + gap_size + 1U >= LED_MATRIX_HEIGHT);
 
-    o->distance = data->new_obstacle_distance;
+    return obstacle_tile(gap_top, gap_size);
+}
 
-    data->obstacles_numof++;
+static void draw_obstacles(void)
+{
+    led_matrix_bitboard_draw(&data->obstacles, LED_MATRIX_BRIGHTNESS_MAX);
 }
 
-static bool step_and_is_crashing(void)
+static bool update(void *arg, const led_matrix_games_input_t *input)
 {
-    if (data->first_obstacle_x == 0) {
-        assume(data->obstacles_numof > 0);
-        data->first_obstacle_x = obstacle(0)->distance - 1;
-        data->obstacles_numof--;
-        data->obstacles_pos++;
-        if ((data->score & 0x3) == 0x0) {
-            if (data->new_obstacle_distance > 3) {
-                data->new_obstacle_distance--;
-            }
-        }
-        data->score++;
-        spawn_abstacle();
+    (void)arg;
+
+    data->y_offset -= 2 * input->presses;
+
+    if (data->step_tick == STEP_TICKS) {
+        /* sinking by one pixel per step */
+        data->y_offset++;
+        data->step_tick = 0;
     }
-    else {
-        data->first_obstacle_x--;
+
+    if ((data->step_tick == 0) && led_matrix_games_scroller_advance(&data->scroller)) {
+        /* an obstacle was passed */
+        data->score++;
     }
 
-    if (data->first_obstacle_x == 1) {
-        struct flappy_led_obstacle *o = obstacle(0);
-        static const int y = LED_MATRIX_HEIGHT / 2;
-        if ((y < o->gap_top - data->y_offset) || (y >= o->gap_top + o->gap_size - data->y_offset)) {
-            return true;
-        }
+    led_matrix_games_scroller_bitboard(&data->scroller, data->y_offset + TILE_YSHIFT,
+                                       &data->obstacles);
+
+    /* crashing is only checked once per step */
+    if ((data->step_tick == 0) && led_matrix_bitboard_overlaps(&data->obstacles, &flappy)) {
+        return false;
     }
 
-    return false;
+    data->step_tick++;
+    return true;
 }
 
-static void assert_obstancle_array_length_is_power_of_two(void)
+static void render(void *arg)
 {
-    size_t o_max = ARRAY_SIZE(data->obstacles);
-    /* in addition to checking for it being a power of two, we also
-     * assert it to be at least four items long */
-    assert((o_max >= 4) && ((o_max & (o_max - 1)) == 0));
+    (void)arg;
+
+    /* blink the flappy LED: bright in the first half of every blink */
+    unsigned blink_tick = (data->step_tick - 1) % (2 * BLINK_HALF_PERIOD);
+    uint8_t brightness = (blink_tick < BLINK_HALF_PERIOD) ? LED_MATRIX_BRIGHTNESS_MAX : 1;
+
+    draw_obstacles();
+    led_matrix_fb_set(1, LED_MATRIX_HEIGHT / 2, brightness);
 }
 
-void led_matrix_games_flappy_led(void)
+static void render_crashed(void *arg)
 {
-    assert_obstancle_array_length_is_power_of_two();
+    const int16_t *brightness = arg;
+
+    led_matrix_fb_clear();
+    draw_obstacles();
+    led_matrix_fb_set(1, LED_MATRIX_HEIGHT / 2, *brightness);
+}
 
+static const led_matrix_games_loop_t loop = {
+    .update = update,
+    .render = render,
+    .frames_per_tick = FRAMES_PER_TICK,
+    .catch_up_max = CATCH_UP_MAX,
+};
+
+void led_matrix_games_flappy_led(void)
+{
     memset(data, 0, sizeof(*data));
     data->new_obstacle_distance = LED_MATRIX_WIDTH;
-    data->first_obstacle_x = LED_MATRIX_WIDTH;
-    data-> obstacle_min_gap = 4;
+    data->next_obstacle_x = LED_MATRIX_WIDTH;
+    data->obstacle_min_gap = 4;
 
-    static const char *instructions = "Press any button to gain altitude. Avoid crashing into obstacles.";
     uint8_t btns_pressed;
 
-    led_matrix_text_scroll_until_button(&bitmap_font_matrix_light8,
-                                        instructions, strlen(instructions),
-                                        board_btns_all, &btns_pressed,
-                                        sizeof(btns_pressed),
-                                        LED_MATRIX_BRIGHTNESS_MAX);
+    led_matrix_image_scroll_until_button(&led_matrix_games_msg_flappy_led_instructions,
+                                         board_btns_all, &btns_pressed,
+                                         sizeof(btns_pressed),
+                                         LED_MATRIX_BRIGHTNESS_MAX);
 
     uint32_t target_frame = led_matrix_frame_number();
-    data->seed = target_frame ^ 0x55555555;
-
-    for (unsigned i = 0; i < ARRAY_SIZE(data->obstacles); i++) {
-        if ((i & 0x3) == 0x3) {
-            data->new_obstacle_distance--;
-        }
-        spawn_abstacle();
-    }
-
-    while (1) {
-        if (step_and_is_crashing()) {
-            for (unsigned i = 0; i < 10; i++) {
-                led_matrix_fb_clear();
-                draw_obstacles();
-                led_matrix_fb_set(1, LED_MATRIX_HEIGHT / 2, 0);
-                target_frame = led_matrix_fb_switch(target_frame) + BLINK_HALF_PERIOD;
-
-                led_matrix_fb_clear();
-                draw_obstacles();
-                led_matrix_fb_set(1, LED_MATRIX_HEIGHT / 2, LED_MATRIX_BRIGHTNESS_MAX);
-                target_frame = led_matrix_fb_switch(target_frame) + BLINK_HALF_PERIOD;
-            }
-
-            led_matrix_wait_for_frame(target_frame);
-            const char lost_msg[] = "You lost. Your score:";
-            led_matrix_text_scroll(&bitmap_font_matrix_light8,
-                                   lost_msg, sizeof(lost_msg) - 1, LED_MATRIX_BRIGHTNESS_MAX);
-            char score_str[10];
-            led_matrix_text_scroll(&bitmap_font_matrix_light8,
-                                   score_str, fmt_u32_dec(score_str, data->score),
-                                   LED_MATRIX_BRIGHTNESS_MAX);
-            return;
-        }
-
-        uint8_t btns_old = 0;
-        for (unsigned blink = 0; blink < BLINKS_PER_STEP; blink++) {
-            uint8_t brightness = LED_MATRIX_BRIGHTNESS_MAX;
-            for (unsigned j = 0; j < 2; j++) {
-                for (unsigned i = 0; i < BLINK_HALF_PERIOD; i++) {
-                    led_matrix_fb_clear();
-                    draw_obstacles();
-                    led_matrix_fb_set(1, LED_MATRIX_HEIGHT / 2, brightness);
-                    target_frame = led_matrix_fb_switch(target_frame) + 1;
-                    button_matrix_scan(&btns_pressed);
-                    if (btns_pressed && (btns_pressed != btns_old)) {
-                        data->y_offset -= 2;
-                    }
-                    btns_old = btns_pressed;
-                }
-                brightness = 1;
-            }
-        }
-
-        data->y_offset++;
-
-    }
+    data->seed = led_matrix_games_seed();
+    led_matrix_games_scroller_init(&data->scroller, gen_column, NULL);
+
+    target_frame = led_matrix_games_loop_run(&loop, target_frame, NULL);
+
+    /* crashed: blink the flappy LED */
+    led_matrix_timeline_t timeline = { 0 };
+    int16_t brightness = 0;
+    led_matrix_tween_t blink = {
+        .value = &brightness,
+        .from = 0,
+        .to = LED_MATRIX_BRIGHTNESS_MAX,
+        .duration = CRASH_BLINK_FRAMES,
+        .ease = LED_MATRIX_EASE_STEP,
+        .repeat = CRASH_BLINKS - 1,
+    };
+    led_matrix_timeline_add(&timeline, &blink, target_frame);
+    target_frame = led_matrix_timeline_play(&timeline, target_frame, render_crashed, &brightness);
+
+    led_matrix_wait_for_frame(target_frame);
+    led_matrix_anim_play(&led_matrix_games_anim_crash);
+    led_matrix_image_scroll(&led_matrix_games_msg_flappy_led_lost,
+                            LED_MATRIX_BRIGHTNESS_MAX);
+    char score_str[10];
+    led_matrix_text_scroll(&bitmap_font_matrix_light8,
+                           score_str, fmt_u32_dec(score_str, data->score),
+                           LED_MATRIX_BRIGHTNESS_MAX);
+#if MODULE_FLASH_KV
+    led_matrix_games_highscore(FLASH_KV_KEY_FLAPPY_LED_HIGHSCORE, data->score);
+#endif
 }
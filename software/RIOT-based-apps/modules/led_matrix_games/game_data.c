@@ -1,2 +1,9 @@
 #include "led_matrix_games.h"
 led_matrix_games_data_t led_matrix_games_data;
+
+#if !MODULE_LED_MATRIX_GAMES_RECORD && !MODULE_LED_MATRIX_GAMES_REPLAY
+uint32_t led_matrix_games_seed(void)
+{
+    return led_matrix_frame_number() ^ 0x55555555;
+}
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_games
+ * @{
+ *
+ * @file
+ * @brief       Fixed-timestep game loop
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "button_matrix_events.h"
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+
+static void sample_input(led_matrix_games_input_t *input)
+{
+    button_matrix_event_t event;
+
+    memset(input, 0, sizeof(*input));
+    while (button_matrix_events_try_get(&event)) {
+        uint8_t mask = 1U << (event.button & 0x7);
+        unsigned idx = event.button >> 3;
+        switch (event.type) {
+        case BUTTON_MATRIX_EVENT_PRESS:
+            input->pressed[idx] |= mask;
+            input->presses++;
+            break;
+        case BUTTON_MATRIX_EVENT_RELEASE:
+            input->released[idx] |= mask;
+            break;
+        default:
+            input->long_pressed[idx] |= mask;
+            break;
+        }
+    }
+
+    button_matrix_events_state(input->held);
+}
+
+uint32_t led_matrix_games_loop_run(const led_matrix_games_loop_t *loop,
+                                   uint32_t start_frame,
+                                   led_matrix_games_loop_stats_t *stats)
+{
+    assert((loop != NULL) && (loop->update != NULL) && (loop->render != NULL));
+    assert(loop->frames_per_tick > 0);
+
+    led_matrix_games_loop_stats_t unused = { 0 };
+    if (stats == NULL) {
+        stats = &unused;
+    }
+
+    led_matrix_games_input_t input;
+    uint32_t next_frame = start_frame;
+    unsigned behind = 0;
+
+    while (1) {
+        sample_input(&input);
+        stats->ticks++;
+        if (!loop->update(loop->arg, &input)) {
+            return next_frame;
+        }
+
+        if (behind) {
+            behind--;
+            stats->ticks_caught_up++;
+            next_frame += loop->frames_per_tick;
+            continue;
+        }
+
+        led_matrix_fb_clear();
+        loop->render(loop->arg);
+        /* a frame switch requested in time is shown in the frame after the
+         * one given */
+        int32_t late = led_matrix_fb_switch(next_frame) - (next_frame + 1);
+        stats->frames_rendered++;
+        next_frame += loop->frames_per_tick;
+
+        if (late <= 0) {
+            continue;
+        }
+
+        stats->frames_late++;
+        stats->late_sum += late;
+        if ((uint32_t)late > stats->late_max) {
+            stats->late_max = late;
+        }
+
+        /* ticks whose frames are already in the past */
+        unsigned missed = (unsigned)late / loop->frames_per_tick;
+        behind = (missed < loop->catch_up_max) ? missed : loop->catch_up_max;
+        stats->ticks_skipped += missed - behind;
+        next_frame += (missed - behind) * loop->frames_per_tick;
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_games
+ * @{
+ *
+ * @file
+ * @brief       High scores kept in flash
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "bitmap_fonts.h"
+#include "flash_kv.h"
+#include "fmt.h"
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+
+void led_matrix_games_highscore(unsigned key, uint32_t score)
+{
+    static const char prefix[] = "Best ";
+    uint32_t highscore = flash_kv_get_u32(key, 0);
+
+    /* store it first, so that the score is not lost when switching off
+     * the device during the message. If storing fails, the old high score is
+     * shown as usual */
+    if ((score > highscore) && (flash_kv_set_u32(key, score) == 0)) {
+        static const char msg[] = "New high score!";
+        led_matrix_text_scroll(&bitmap_font_matrix_light8, msg, sizeof(msg) - 1,
+                               LED_MATRIX_BRIGHTNESS_MAX);
+        return;
+    }
+
+    char text[sizeof(prefix) - 1 + 10];
+    memcpy(text, prefix, sizeof(prefix) - 1);
+    size_t len = sizeof(prefix) - 1 + fmt_u32_dec(&text[sizeof(prefix) - 1], highscore);
+    led_matrix_text_scroll(&bitmap_font_matrix_light8, text, len, LED_MATRIX_BRIGHTNESS_MAX);
+}
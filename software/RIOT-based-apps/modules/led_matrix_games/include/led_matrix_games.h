@@ -28,37 +28,149 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "button_matrix_params.h"
+#include "led_matrix.h"
+#include "led_matrix_bitboard.h"
+#include "led_matrix_params.h"
+
+#if MODULE_LED_MATRIX_GAMES_RECORD || MODULE_LED_MATRIX_GAMES_REPLAY
+#include "button_matrix_script.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @name    Types needed for the flappy LED game
+ * @name    Side-scrolling engine
+ *
+ * The level of a side-scroller is a sequence of columns, generated one
+ * after the other by a callback as they scroll into view. Every column is a
+ * bit mask (a tile) of up to 16 rows, with bit 0 being the topmost. The
+ * visible columns are kept in a ring, so scrolling by one column only moves
+ * the index of the leftmost one and generates a single new column. Drawing
+ * writes every visible column with a single @ref led_matrix_fb_column.
+ *
+ * Levels can be taller than the screen: A vertical offset selects the rows
+ * shown, with rows beyond the top or bottom of the tile repeating its first
+ * or last row, respectively.
  * @{
  */
+/**
+ * @brief   Number of columns in the ring of a side-scroller (must be a
+ *          power of two of at least @ref LED_MATRIX_WIDTH)
+ */
+#ifndef CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS
+#  define CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS  16
+#endif
 
 /**
- * @brief   An obstacle to fly through
+ * @brief   Generate the column of the level at the given position
+ *
+ * @param[in]   arg     The argument passed to
+ *                      @ref led_matrix_games_scroller_init
+ * @param[in]   x       Position of the column in the level, the columns
+ *                      are generated in order starting from 0
+ *
+ * @return  The tile of the column
+ */
+typedef uint16_t (*led_matrix_games_scroller_gen_t)(void *arg, uint32_t x);
+
+/**
+ * @brief   State of a side-scroller
+ */
+typedef struct {
+    uint16_t columns[CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS]; /**< Ring of tiles */
+    led_matrix_games_scroller_gen_t gen;    /**< Level generator */
+    void *arg;                              /**< Argument of gen */
+    uint32_t x;                             /**< Level position of the leftmost column shown */
+} led_matrix_games_scroller_t;
+
+/**
+ * @brief   Start a level at its first column, generating the columns on
+ *          screen
+ *
+ * @param[out]  scroller    The side-scroller to initialize
+ * @param[in]   gen         Level generator
+ * @param[in]   arg         Argument to pass to @p gen
+ */
+void led_matrix_games_scroller_init(led_matrix_games_scroller_t *scroller,
+                                    led_matrix_games_scroller_gen_t gen,
+                                    void *arg);
+
+/**
+ * @brief   Scroll to the left by one column
+ *
+ * @param[in,out]   scroller    The side-scroller to advance
+ *
+ * @return  The tile of the column that left the screen
+ */
+uint16_t led_matrix_games_scroller_advance(led_matrix_games_scroller_t *scroller);
+
+/**
+ * @brief   Get the tile of a column on screen
+ *
+ * @param[in]   scroller    The side-scroller
+ * @param[in]   x           Screen X-coordinate of the column
+ */
+static inline uint16_t led_matrix_games_scroller_tile(const led_matrix_games_scroller_t *scroller,
+                                                      unsigned x)
+{
+    return scroller->columns[(scroller->x + x) & (CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS - 1)];
+}
+
+/**
+ * @brief   Get the rows of a tile to show on screen
+ *
+ * @param[in]   tile        The tile
+ * @param[in]   yshift      Row of the tile to show topmost on screen, may
+ *                          be negative or beyond the tile
+ *
+ * @return  Bit mask of the rows on screen, bit 0 being the topmost
+ */
+unsigned led_matrix_games_scroller_rows(uint16_t tile, int yshift);
+
+/**
+ * @brief   Draw the columns on screen to the scratch framebuffer
+ *
+ * @param[in]   scroller    The side-scroller to draw
+ * @param[in]   yshift      Row of the tiles to show topmost on screen
+ * @param[in]   brightness  Brightness of the pixels set in the tiles
+ */
+void led_matrix_games_scroller_draw(const led_matrix_games_scroller_t *scroller,
+                                    int yshift, uint8_t brightness);
+
+/**
+ * @brief   Get the columns on screen as bitboard, e.g. to test for
+ *          collisions
+ *
+ * @param[in]   scroller    The side-scroller
+ * @param[in]   yshift      Row of the tiles to show topmost on screen
+ * @param[out]  bb          The bitboard to write the columns to
+ */
+void led_matrix_games_scroller_bitboard(const led_matrix_games_scroller_t *scroller,
+                                        int yshift, led_matrix_bitboard_t *bb);
+/** @} */
+
+/**
+ * @name    Types needed for the flappy LED game
+ * @{
  */
-struct flappy_led_obstacle {
-    uint8_t gap_top;
-    uint8_t gap_size;
-    uint8_t distance;
-};
 
 /**
  * @brief   Game data for the flappy LED game
  */
 struct flappy_led_game_data {
+    led_matrix_games_scroller_t scroller;       /**< The obstacles scrolling by */
+    led_matrix_bitboard_t obstacles;            /**< The obstacles on screen */
     uint32_t seed;                              /**< Current PRNG seed */
     uint32_t score;                             /**< Current score */
+    uint32_t next_obstacle_x;                   /**< Level position of the next obstacle */
+    uint32_t obstacles_numof;                   /**< Number of obstacles generated */
     int y_offset;                               /**< Used to track the current altitude of the flappy LED */
-    struct flappy_led_obstacle obstacles[8];    /**< Obstacles currently tracked as ring buffer */
-    uint8_t obstacles_numof;                    /**< Current number of obstacles */
-    uint8_t obstacles_pos;                      /**< position of the first obstacle in the ring buffer */
     uint8_t new_obstacle_distance;              /**< Distance to spawn a new obstacle with */
-    uint8_t first_obstacle_x;                   /**< X coordinate of the first obstacle */
     uint8_t obstacle_min_gap;                   /**< Minimum size of the gap in an obstacle */
+    uint8_t step_tick;                          /**< Tick of the game loop within the current step */
 };
 /** @} */
 
@@ -77,6 +189,13 @@ typedef union {
  */
 extern led_matrix_games_data_t led_matrix_games_data;
 
+/**
+ * @brief   Explosion shown when crashing in flappy LED
+ *
+ * Encoded from `dist/crash/` using `led_matrix/dist/anim2c.py`
+ */
+extern const led_matrix_anim_t led_matrix_games_anim_crash;
+
 /**
  * @brief   Get the next PRNG sequence value
  * @param[in]   x       The previous value
@@ -92,6 +211,260 @@ static inline uint32_t xorshift32(uint32_t x)
     return x;
 }
 
+/**
+ * @brief   Get the seed for the PRNG of a game
+ *
+ * The seed is derived from the current frame number, unless a replay is
+ * running (see @ref led_matrix_games_replay_start).
+ */
+uint32_t led_matrix_games_seed(void);
+
+/**
+ * @brief   Show the high score of a game, and store the score just reached
+ *          if it beats the high score
+ *
+ * @param[in]   key     Key of the high score in the store, see
+ *                      @ref sys_flash_kv
+ * @param[in]   score   The score just reached
+ *
+ * This is only available with module `flash_kv`, in which case the games
+ * call it after showing the score.
+ */
+void led_matrix_games_highscore(unsigned key, uint32_t score);
+
+/**
+ * @name    Recording and replaying games
+ *
+ * The games are deterministic, except for the button input and the seeds
+ * returned by @ref led_matrix_games_seed. With module
+ * `led_matrix_games_record` both are recorded, with module
+ * `led_matrix_games_replay` they are fed back in: The seeds are returned in
+ * the recorded order and the button state is played back by
+ * `button_matrix_script`, so the games read it through the usual button API
+ * and render the same sequence of frames. This works on the hardware and on
+ * the `native` board alike.
+ *
+ * The button state is recorded once per scan by `button_matrix_record`, so
+ * replays are exact when scanning once per frame (the default of
+ * `button_matrix_events_led`) and the game keeps up with the frame rate.
+ *
+ * Both modules provide @ref led_matrix_games_seed, so only one of them can
+ * be used at a time.
+ * @{
+ */
+#if MODULE_LED_MATRIX_GAMES_RECORD || MODULE_LED_MATRIX_GAMES_REPLAY || DOXYGEN
+/**
+ * @brief   Maximum number of seeds to record
+ */
+#ifndef CONFIG_LED_MATRIX_GAMES_RECORD_SEEDS_MAX
+#  define CONFIG_LED_MATRIX_GAMES_RECORD_SEEDS_MAX  16
+#endif
+
+/**
+ * @brief   A recorded session
+ */
+typedef struct {
+    const uint32_t *seeds;                      /**< Seeds in the order used */
+    const button_matrix_script_step_t *steps;   /**< Recorded button state */
+    uint16_t seeds_numof;                       /**< Number of entries in seeds */
+    uint16_t steps_numof;                       /**< Number of entries in steps */
+} led_matrix_games_replay_t;
+
+/**
+ * @brief   Start recording the seeds and the button input
+ *
+ * Frame numbers in the recording are relative to this call, so start the
+ * replay at the corresponding point of the application.
+ */
+void led_matrix_games_record_start(void);
+
+/**
+ * @brief   Print everything recorded so far via stdio as C source code
+ *          defining a @ref led_matrix_games_replay_t of the given name
+ *
+ * @param[in]   name    Name of the variable holding the replay
+ */
+void led_matrix_games_record_print(const char *name);
+
+/**
+ * @brief   Start replaying a recorded session
+ *
+ * @param[in]   replay  The session to replay, must remain valid during the
+ *                      replay
+ *
+ * Once the recorded seeds are exhausted, seeds are derived from the frame
+ * number again.
+ */
+void led_matrix_games_replay_start(const led_matrix_games_replay_t *replay);
+#endif /* MODULE_LED_MATRIX_GAMES_RECORD || MODULE_LED_MATRIX_GAMES_REPLAY */
+/** @} */
+
+/**
+ * @name    Fixed-timestep game loop
+ *
+ * @ref led_matrix_games_loop_run drives a game by calling its update
+ * callback once per tick of a fixed number of frames, and its render
+ * callback to draw the result into the scratch framebuffer, which is then
+ * shown at the scheduled frame. The button events are collected before each
+ * tick and passed to the update callback.
+ *
+ * The schedule is kept independent of how long update and render take. When
+ * the loop falls behind, e.g. because rendering took longer than a tick, it
+ * catches up by running up to `catch_up_max` updates without rendering, so
+ * that the game keeps its speed. Ticks beyond that are skipped, which slows
+ * the game down for a moment instead. Either way, every late frame is
+ * recorded in the statistics.
+ * @{
+ */
+/**
+ * @brief   Number of bytes of the button bit vectors
+ */
+#define LED_MATRIX_GAMES_BTN_BYTES  ((BUTTON_MATRIX_BUTTON_NUMOF + 7) / 8)
+
+/**
+ * @brief   Input sampled for a tick of the game loop
+ *
+ * The bit vectors use the same format as @ref button_matrix_scan
+ */
+typedef struct {
+    uint8_t pressed[LED_MATRIX_GAMES_BTN_BYTES];    /**< Pressed since the last tick */
+    uint8_t released[LED_MATRIX_GAMES_BTN_BYTES];   /**< Released since the last tick */
+    uint8_t long_pressed[LED_MATRIX_GAMES_BTN_BYTES];   /**< Long press reported since the last tick */
+    uint8_t held[LED_MATRIX_GAMES_BTN_BYTES];       /**< Currently held down */
+    uint8_t presses;                                /**< Number of presses since the last tick */
+} led_matrix_games_input_t;
+
+/**
+ * @brief   A game driven by the game loop
+ */
+typedef struct {
+    /**
+     * @brief   Advance the game by one tick
+     *
+     * @retval  true    Continue the game
+     * @retval  false   Game over, the loop returns without rendering
+     */
+    bool (*update)(void *arg, const led_matrix_games_input_t *input);
+    /**
+     * @brief   Render the current state into the scratch framebuffer
+     *
+     * The scratch framebuffer is cleared before the call.
+     */
+    void (*render)(void *arg);
+    void *arg;                  /**< Argument passed to the callbacks */
+    uint8_t frames_per_tick;    /**< Length of a tick in frames */
+    uint8_t catch_up_max;       /**< Updates to run without rendering when behind */
+} led_matrix_games_loop_t;
+
+/**
+ * @brief   Timing statistics of the game loop
+ */
+typedef struct {
+    uint32_t ticks;             /**< Updates run */
+    uint32_t frames_rendered;   /**< Frames rendered and shown */
+    uint32_t frames_late;       /**< Frames shown later than scheduled */
+    uint32_t late_sum;          /**< Sum of the delays of late frames in frames */
+    uint32_t late_max;          /**< Highest delay of a frame in frames */
+    uint32_t ticks_caught_up;   /**< Updates run without rendering */
+    uint32_t ticks_skipped;     /**< Ticks skipped altogether */
+} led_matrix_games_loop_stats_t;
+
+/**
+ * @brief   Run a game until its update callback returns false
+ *
+ * @param[in]       loop        The game to run
+ * @param[in]       start_frame The frame to show the first rendering at,
+ *                              e.g. @ref led_matrix_frame_number
+ * @param[in,out]   stats       Statistics to add to, or `NULL`
+ *
+ * @return  The frame the next rendering would have been shown at, to
+ *          continue the schedule with e.g. an animation
+ */
+uint32_t led_matrix_games_loop_run(const led_matrix_games_loop_t *loop,
+                                   uint32_t start_frame,
+                                   led_matrix_games_loop_stats_t *stats);
+/** @} */
+
+/**
+ * @name    Game of Life
+ *
+ * Conway's Game of Life on a board of the size of the LED matrix, wrapping
+ * around at the edges (a torus). The board is a bitboard, so every column
+ * is a bit mask with bit 0 being the topmost row.
+ *
+ * A generation is computed column by column with bitwise operations only:
+ * The live cells around all cells of a column are counted at once by adding
+ * the bit masks of the neighboring rows and columns with bit-sliced adders,
+ * rather than counting cell by cell.
+ *
+ * Boards that died out, stopped changing, or oscillate are detected with a
+ * history of hashes of the last generations. Cycles longer than the history
+ * (e.g. a glider travelling around the torus) are not detected, so the
+ * attract mode starts over after
+ * @ref CONFIG_LED_MATRIX_GAMES_LIFE_GENERATIONS_MAX generations as well.
+ * @{
+ */
+/**
+ * @brief   Number of generations to look back for a repeated board
+ */
+#ifndef CONFIG_LED_MATRIX_GAMES_LIFE_HISTORY
+#  define CONFIG_LED_MATRIX_GAMES_LIFE_HISTORY          8
+#endif
+
+/**
+ * @brief   Number of generations after which the attract mode starts over
+ */
+#ifndef CONFIG_LED_MATRIX_GAMES_LIFE_GENERATIONS_MAX
+#  define CONFIG_LED_MATRIX_GAMES_LIFE_GENERATIONS_MAX  1000
+#endif
+
+/**
+ * @brief   State of a Game of Life
+ */
+typedef struct {
+    led_matrix_bitboard_t cells;        /**< Live cells */
+    uint32_t history[CONFIG_LED_MATRIX_GAMES_LIFE_HISTORY]; /**< Hashes of the last boards */
+    uint32_t generation;                /**< Number of the current generation */
+} led_matrix_games_life_t;
+
+/**
+ * @brief   Start a Game of Life with a random board
+ *
+ * @param[out]  life    The game to start
+ * @param[in]   seed    Seed of the PRNG filling the board
+ */
+void led_matrix_games_life_seed(led_matrix_games_life_t *life, uint32_t seed);
+
+/**
+ * @brief   Compute the next generation
+ *
+ * @param[in,out]   life    The game to advance
+ *
+ * @retval  true    The new board has already been seen within the last
+ *                  @ref CONFIG_LED_MATRIX_GAMES_LIFE_HISTORY generations
+ * @retval  false   Otherwise
+ */
+bool led_matrix_games_life_step(led_matrix_games_life_t *life);
+
+/**
+ * @brief   Render the board into the scratch framebuffer
+ *
+ * @param[in]   life        The game to render
+ * @param[in]   brightness  Brightness of live cells
+ */
+void led_matrix_games_life_render(const led_matrix_games_life_t *life, uint8_t brightness);
+
+/**
+ * @brief   Run the Game of Life as attract mode until a button is pressed
+ *
+ * @pre     @ref led_matrix_init and @ref button_matrix_init has been called
+ *
+ * Once a board is found to repeat, it is shown a little longer before
+ * starting over with a new random board.
+ */
+void led_matrix_games_life(void);
+/** @} */
+
 /**
  * @brief   Run the flappy LED game until one game is over
  *
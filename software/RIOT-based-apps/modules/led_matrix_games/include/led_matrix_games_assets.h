@@ -0,0 +1,21 @@
+/* This file is auto generated using assets2c.py */
+#ifndef LED_MATRIX_GAMES_ASSETS_H
+#define LED_MATRIX_GAMES_ASSETS_H
+
+#include "bitmap_fonts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const bitmap_glyph_t led_matrix_games_msg_flappy_led_instructions; /**< Pre-rendered 'Press any button to gain altitude. Avoid crashing into obstacles.' */
+extern const bitmap_glyph_t led_matrix_games_msg_flappy_led_lost; /**< Pre-rendered 'You lost. Your score:' */
+extern const bitmap_glyph_t led_matrix_games_msg_ledmon_says_instructions; /**< Pre-rendered 'Memorize the button sequence shown and enter it. Press any button to start' */
+extern const bitmap_glyph_t led_matrix_games_msg_you_lost; /**< Pre-rendered 'You lost' */
+extern const bitmap_glyph_t led_matrix_games_msg_your_score; /**< Pre-rendered 'Your score:' */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_GAMES_ASSETS_H */
@@ -2,16 +2,29 @@
 
 #include "board.h"
 #include "button_matrix.h"
+#include "button_matrix_events.h"
+#include "button_matrix_params.h"
 #include "fmt.h"
 #include "led_matrix.h"
 #include "led_matrix_games.h"
+#include "led_matrix_games_assets.h"
 #include "led_matrix_params.h"
+#include "led_matrix_timeline.h"
+
+#if MODULE_FLASH_KV
+#include "flash_kv.h"
+#endif
 
 #define GLYPH_FRAMES        60
 #define GLYPH_MIN_FRAMES    10
 #define BLANK_FRAMES        30
-#define BLINK_FRAMES        5
 #define BLINK_LOOPS         6
+/* The waits above start at the frame returned by led_matrix_fb_switch(),
+ * which already shows the new content. On a timeline the same timing takes
+ * these frame counts */
+#define GLYPH_SHOWN_FRAMES  61      /**< Frames a glyph is shown */
+#define BLANK_SHOWN_FRAMES  31      /**< Blank frames after a glyph */
+#define BLINK_SHOWN_FRAMES  6       /**< Frames per half period of blinking */
 
 static const bitmap_glyph_t * const arrows[] = {
     &bitmap_glyph_arrow_up,
@@ -84,32 +97,55 @@ static bitmap_glyph_t glyph_by_key(uint8_t key)
     }
 }
 
-static uint32_t flash_glyph_once(bitmap_glyph_t glyph, uint32_t target_frame)
+struct glyph_anim {
+    led_matrix_timeline_t timeline;
+    bitmap_glyph_t glyph;
+    int16_t brightness;
+};
+
+static void render_glyph(void *arg)
 {
-    led_matrix_fb_clear();
-    led_matrix_glyph(&glyph,
-                     (LED_MATRIX_WIDTH - glyph.width) / 2, (LED_MATRIX_HEIGHT - 8) / 2,
-                     LED_MATRIX_BRIGHTNESS_MAX);
+    struct glyph_anim *anim = arg;
 
-    target_frame = led_matrix_fb_switch(target_frame) + GLYPH_FRAMES;
     led_matrix_fb_clear();
-    return led_matrix_fb_switch(target_frame) + BLANK_FRAMES;
+    led_matrix_glyph(&anim->glyph,
+                     (LED_MATRIX_WIDTH - anim->glyph.width) / 2,
+                     (LED_MATRIX_HEIGHT - anim->glyph.height) / 2,
+                     anim->brightness);
 }
 
-static uint32_t blink_glyph(bitmap_glyph_t glyph, uint32_t target_frame)
+static uint32_t flash_glyph_once(bitmap_glyph_t glyph, uint32_t target_frame)
 {
-    for (unsigned loop = 0; loop < BLINK_LOOPS; loop++) {
-        led_matrix_fb_clear();
-        led_matrix_glyph(&glyph,
-                         (LED_MATRIX_WIDTH - glyph.width) / 2, (LED_MATRIX_HEIGHT - 8) / 2,
-                         LED_MATRIX_BRIGHTNESS_MAX);
-
-        target_frame = led_matrix_fb_switch(target_frame) + BLINK_FRAMES;
-        led_matrix_fb_clear();
-        target_frame =  led_matrix_fb_switch(target_frame) + BLINK_FRAMES;
-    }
+    struct glyph_anim anim = { .glyph = glyph };
+    led_matrix_tween_t show = {
+        .value = &anim.brightness,
+        .to = LED_MATRIX_BRIGHTNESS_MAX,
+    };
+    led_matrix_tween_t hide = {
+        .value = &anim.brightness,
+        .to = 0,
+    };
+
+    led_matrix_timeline_add(&anim.timeline, &show, target_frame);
+    led_matrix_timeline_add(&anim.timeline, &hide, target_frame + GLYPH_SHOWN_FRAMES);
+    target_frame = led_matrix_timeline_play(&anim.timeline, target_frame, render_glyph, &anim);
+    return target_frame + BLANK_SHOWN_FRAMES;
+}
 
-    return target_frame;
+static uint32_t blink_glyph(bitmap_glyph_t glyph, uint32_t target_frame)
+{
+    struct glyph_anim anim = { .glyph = glyph };
+    led_matrix_tween_t blink = {
+        .value = &anim.brightness,
+        .from = LED_MATRIX_BRIGHTNESS_MAX,
+        .to = 0,
+        .duration = 2 * BLINK_SHOWN_FRAMES,
+        .ease = LED_MATRIX_EASE_STEP,
+        .repeat = BLINK_LOOPS - 1,
+    };
+
+    led_matrix_timeline_add(&anim.timeline, &blink, target_frame);
+    return led_matrix_timeline_play(&anim.timeline, target_frame, render_glyph, &anim);
 }
 
 static inline void show_failed(bitmap_glyph_t glyph, uint32_t sequence_length, uint32_t target_frame)
@@ -117,15 +153,14 @@ static inline void show_failed(bitmap_glyph_t glyph, uint32_t sequence_length, u
     target_frame = blink_glyph(glyph, target_frame);
     flash_glyph_once(bitmap_glyph_thumb_down, target_frame);
 
-    static const char *msg_you_lost = "You lost";
-    led_matrix_text_scroll(&bitmap_font_matrix_light8, msg_you_lost, strlen(msg_you_lost),
-                           LED_MATRIX_BRIGHTNESS_MAX);
-    static const char *msg_your_score = "Your score:";
-    led_matrix_text_scroll(&bitmap_font_matrix_light8, msg_your_score, strlen(msg_your_score),
-                           LED_MATRIX_BRIGHTNESS_MAX);
+    led_matrix_image_scroll(&led_matrix_games_msg_you_lost, LED_MATRIX_BRIGHTNESS_MAX);
+    led_matrix_image_scroll(&led_matrix_games_msg_your_score, LED_MATRIX_BRIGHTNESS_MAX);
     char score[10];
     size_t score_len = fmt_u32_dec(score, sequence_length);
     led_matrix_text_scroll(&bitmap_font_matrix_light8, score, score_len, LED_MATRIX_BRIGHTNESS_MAX);
+#if MODULE_FLASH_KV
+    led_matrix_games_highscore(FLASH_KV_KEY_LEDMON_SAYS_HIGHSCORE, sequence_length);
+#endif
 }
 
 static uint32_t show_sequence(uint32_t seed, uint32_t sequence_length, uint32_t target_frame)
@@ -140,32 +175,37 @@ static uint32_t show_sequence(uint32_t seed, uint32_t sequence_length, uint32_t
 
 static bool input_sequence_is_correct(uint32_t seed, uint32_t sequence_length, uint32_t *target_frame)
 {
-    uint8_t btns_pressed[1];
+    button_matrix_event_t event;
+
+    /* ignore buttons pressed while the sequence was shown */
+    button_matrix_events_flush();
 
     for (uint32_t i = 0; i < sequence_length; i++) {
         do {
-            button_matrix_scan(btns_pressed);
-        } while (btns_pressed[0] == 0);
+            button_matrix_events_get(&event);
+        } while (event.type != BUTTON_MATRIX_EVENT_PRESS);
 
+        uint8_t btn = 1U << event.button;
         led_matrix_fb_clear();
-        bitmap_glyph_t glyph = glyph_by_key(btns_pressed[0]);
+        bitmap_glyph_t glyph = glyph_by_key(btn);
         uint8_t btn_correct = simon_next_btn(&seed);
-        if (btns_pressed[0] != btn_correct) {
+        if (btn != btn_correct) {
             show_failed(glyph, sequence_length, *target_frame);
             return false;
         }
         led_matrix_glyph(&glyph,
-                         (LED_MATRIX_WIDTH - glyph.width) / 2, (LED_MATRIX_HEIGHT - 8) / 2,
+                         (LED_MATRIX_WIDTH - glyph.width) / 2, (LED_MATRIX_HEIGHT - glyph.height) / 2,
                          LED_MATRIX_BRIGHTNESS_MAX);
 
         *target_frame = led_matrix_fb_switch(*target_frame);
         for (unsigned i = 0; i < GLYPH_FRAMES; i++) {
             *target_frame += 1;
             led_matrix_wait_for_frame(*target_frame);
-            button_matrix_scan(btns_pressed);
-            if (btns_pressed[0] == 0) {
+            uint8_t btns_pressed;
+            button_matrix_events_state(&btns_pressed);
+            if (!(btns_pressed & btn)) {
                 if (i < GLYPH_MIN_FRAMES) {
-                    target_frame += GLYPH_MIN_FRAMES - i;
+                    *target_frame += GLYPH_MIN_FRAMES - i;
                 }
                 break;
             }
@@ -181,20 +221,18 @@ static bool input_sequence_is_correct(uint32_t seed, uint32_t sequence_length, u
 
 void led_matrix_games_ledmon_says(void)
 {
-    static const char *instructions = "Memorize the button sequence shown and enter it. Press any button to start";
     uint8_t btns_pressed[1];
-    led_matrix_text_scroll_until_button(&bitmap_font_matrix_light8,
-                                        instructions, strlen(instructions),
-                                        board_btns_all, btns_pressed,
-                                        sizeof(btns_pressed),
-                                        LED_MATRIX_BRIGHTNESS_MAX);
+    led_matrix_image_scroll_until_button(&led_matrix_games_msg_ledmon_says_instructions,
+                                         board_btns_all, btns_pressed,
+                                         sizeof(btns_pressed),
+                                         LED_MATRIX_BRIGHTNESS_MAX);
 
     uint32_t target_frame;
     uint32_t seed;
     uint32_t sequence_length;
 
     target_frame = led_matrix_frame_number();
-    seed = target_frame ^ 0x55555555;
+    seed = led_matrix_games_seed();
     sequence_length = 0;
 
     while (1) {
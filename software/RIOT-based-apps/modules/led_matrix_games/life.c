@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_games
+ * @{
+ *
+ * @file
+ * @brief       Game of Life with a bit-parallel generation step
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "button_matrix_events.h"
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+#include "led_matrix_params.h"
+
+#define FRAMES_PER_GENERATION   8
+/* generations to keep showing a board that repeats */
+#define LINGER_GENERATIONS      16
+
+static_assert(LED_MATRIX_HEIGHT <= 16, "columns are 16 rows high");
+
+static uint32_t hash(const led_matrix_bitboard_t *cells)
+{
+    uint32_t h = 2166136261U;
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        h = (h ^ cells->cols[x]) * 16777619U;
+    }
+    return h;
+}
+
+void led_matrix_games_life_seed(led_matrix_games_life_t *life, uint32_t seed)
+{
+    uint32_t rnd = seed ? seed : 1;
+
+    memset(life, 0, sizeof(*life));
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        rnd = xorshift32(rnd);
+        /* (1 - 1/4) * 1/2: about 3 in 8 cells alive */
+        life->cells.cols[x] = ((rnd | (rnd >> 9)) & (rnd >> 18)) & LED_MATRIX_BITBOARD_COLUMN_MASK;
+    }
+}
+
+bool led_matrix_games_life_step(led_matrix_games_life_t *life)
+{
+    /* the number of live cells in every column and the rows above and
+     * below, bit-sliced: bit y of lo and hi are the bits 0 and 1 of the
+     * count of row y */
+    uint16_t lo[LED_MATRIX_WIDTH];
+    uint16_t hi[LED_MATRIX_WIDTH];
+
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        uint32_t c = life->cells.cols[x];
+        uint32_t above = (c << 1) | (c >> (LED_MATRIX_HEIGHT - 1));
+        uint32_t below = (c >> 1) | (c << (LED_MATRIX_HEIGHT - 1));
+        uint32_t t = above ^ below;
+        /* bits past the bottom row are garbage, but never carry into
+         * other rows, so masking the result is enough */
+        lo[x] = t ^ c;
+        hi[x] = (above & below) | (t & c);
+    }
+
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        unsigned l = (x == 0) ? LED_MATRIX_WIDTH - 1 : x - 1;
+        unsigned r = (x == LED_MATRIX_WIDTH - 1) ? 0 : x + 1;
+
+        /* add the three counts (0 to 9, including the cell itself) modulo
+         * 8: 8 and 9 alias 0 and 1, which leave the cell dead as well */
+        uint32_t s0 = lo[l] ^ lo[x] ^ lo[r];
+        uint32_t c0 = (lo[l] & lo[x]) | (lo[r] & (lo[l] ^ lo[x]));
+        uint32_t a = hi[l] ^ hi[x];
+        uint32_t b = hi[r] ^ c0;
+        uint32_t s1 = a ^ b;
+        uint32_t s2 = (hi[l] & hi[x]) ^ (hi[r] & c0) ^ (a & b);
+
+        /* with the cell itself counted: born with 3, survives with 3 or 4 */
+        uint32_t three = s0 & s1 & ~s2;
+        uint32_t four = ~s0 & ~s1 & s2;
+        life->cells.cols[x] = (three | (four & life->cells.cols[x])) & LED_MATRIX_BITBOARD_COLUMN_MASK;
+    }
+
+    uint32_t h = hash(&life->cells);
+    bool seen = false;
+    unsigned numof = (life->generation < CONFIG_LED_MATRIX_GAMES_LIFE_HISTORY)
+                   ? life->generation : CONFIG_LED_MATRIX_GAMES_LIFE_HISTORY;
+    for (unsigned i = 0; i < numof; i++) {
+        seen |= (life->history[i] == h);
+    }
+    life->history[life->generation % CONFIG_LED_MATRIX_GAMES_LIFE_HISTORY] = h;
+    life->generation++;
+
+    return seen;
+}
+
+void led_matrix_games_life_render(const led_matrix_games_life_t *life, uint8_t brightness)
+{
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        led_matrix_fb_column(x, life->cells.cols[x], brightness);
+    }
+}
+
+void led_matrix_games_life(void)
+{
+    led_matrix_games_life_t life;
+    uint32_t frame = led_matrix_frame_number();
+
+    button_matrix_events_flush();
+
+    while (1) {
+        unsigned linger = LINGER_GENERATIONS;
+        led_matrix_games_life_seed(&life, led_matrix_games_seed());
+
+        while (linger && (life.generation < CONFIG_LED_MATRIX_GAMES_LIFE_GENERATIONS_MAX)) {
+            led_matrix_games_life_render(&life, LED_MATRIX_BRIGHTNESS_MAX);
+            frame = led_matrix_fb_switch(frame) + FRAMES_PER_GENERATION;
+
+            if (button_matrix_events_pressed()) {
+                return;
+            }
+
+            if (led_matrix_games_life_step(&life) || (linger < LINGER_GENERATIONS)) {
+                linger--;
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_games
+ * @{
+ *
+ * @file
+ * @brief       Recording and replaying of game sessions
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "button_matrix_script.h"
+#include "container.h"
+#include "irq.h"
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+
+#if MODULE_LED_MATRIX_GAMES_RECORD && MODULE_LED_MATRIX_GAMES_REPLAY
+#  error "led_matrix_games_record and led_matrix_games_replay are mutually exclusive"
+#endif
+
+static uint32_t frame_seed(void)
+{
+    return led_matrix_frame_number() ^ 0x55555555;
+}
+
+#if MODULE_LED_MATRIX_GAMES_RECORD
+static uint32_t seeds[CONFIG_LED_MATRIX_GAMES_RECORD_SEEDS_MAX];
+static unsigned seeds_numof;
+static bool seeds_overflowed;
+
+void led_matrix_games_record_start(void)
+{
+    seeds_numof = 0;
+    seeds_overflowed = false;
+    button_matrix_record_start();
+}
+
+uint32_t led_matrix_games_seed(void)
+{
+    uint32_t seed = frame_seed();
+    if (seeds_numof < ARRAY_SIZE(seeds)) {
+        seeds[seeds_numof++] = seed;
+    }
+    else {
+        seeds_overflowed = true;
+    }
+    return seed;
+}
+
+void led_matrix_games_record_print(const char *name)
+{
+    const button_matrix_script_step_t *steps;
+    size_t steps_numof = button_matrix_record_get(&steps);
+
+    if (button_matrix_record_overflowed() || seeds_overflowed) {
+        puts("/* WARNING: recording incomplete, increase "
+             "CONFIG_BUTTON_MATRIX_RECORD_STEPS_MAX or "
+             "CONFIG_LED_MATRIX_GAMES_RECORD_SEEDS_MAX */");
+    }
+
+    puts("#include \"led_matrix_games.h\"\n");
+    printf("static const uint32_t %s_seeds[] = {\n", name);
+    for (unsigned i = 0; i < seeds_numof; i++) {
+        printf("    0x%08" PRIx32 ",\n", seeds[i]);
+    }
+    puts("};\n");
+
+    printf("static const button_matrix_script_step_t %s_steps[] = {\n", name);
+    for (size_t i = 0; i < steps_numof; i++) {
+        printf("    { .frame = %" PRIu32 ", .scan = 0x%02x },\n",
+               steps[i].frame, (unsigned)steps[i].scan);
+    }
+    puts("};\n");
+
+    printf("const led_matrix_games_replay_t %s = {\n", name);
+    printf("    .seeds = %s_seeds,\n", name);
+    printf("    .steps = %s_steps,\n", name);
+    printf("    .seeds_numof = %u,\n", seeds_numof);
+    printf("    .steps_numof = %u,\n", (unsigned)steps_numof);
+    puts("};");
+}
+#endif /* MODULE_LED_MATRIX_GAMES_RECORD */
+
+#if MODULE_LED_MATRIX_GAMES_REPLAY
+static const led_matrix_games_replay_t *replay;
+static unsigned replay_seed_pos;
+
+void led_matrix_games_replay_start(const led_matrix_games_replay_t *_replay)
+{
+    replay = _replay;
+    replay_seed_pos = 0;
+    button_matrix_script_start(replay->steps, replay->steps_numof);
+}
+
+uint32_t led_matrix_games_seed(void)
+{
+    if (replay && (replay_seed_pos < replay->seeds_numof)) {
+        return replay->seeds[replay_seed_pos++];
+    }
+
+    return frame_seed();
+}
+#endif /* MODULE_LED_MATRIX_GAMES_REPLAY */
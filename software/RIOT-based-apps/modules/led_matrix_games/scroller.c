@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_games
+ * @{
+ *
+ * @file
+ * @brief       Side-scrolling engine
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "led_matrix.h"
+#include "led_matrix_games.h"
+#include "led_matrix_params.h"
+
+#define RING_MASK   (CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS - 1)
+#define SCREEN_MASK ((1U << LED_MATRIX_HEIGHT) - 1)
+
+static_assert((CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS & RING_MASK) == 0,
+              "CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS must be a power of two");
+static_assert(CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS >= LED_MATRIX_WIDTH,
+              "CONFIG_LED_MATRIX_GAMES_SCROLLER_COLUMNS must cover the screen");
+static_assert(LED_MATRIX_HEIGHT <= 16, "tiles are 16 rows high");
+
+void led_matrix_games_scroller_init(led_matrix_games_scroller_t *scroller,
+                                    led_matrix_games_scroller_gen_t gen,
+                                    void *arg)
+{
+    assert((scroller != NULL) && (gen != NULL));
+
+    scroller->gen = gen;
+    scroller->arg = arg;
+    scroller->x = 0;
+
+    for (uint32_t x = 0; x < LED_MATRIX_WIDTH; x++) {
+        scroller->columns[x & RING_MASK] = gen(arg, x);
+    }
+}
+
+uint16_t led_matrix_games_scroller_advance(led_matrix_games_scroller_t *scroller)
+{
+    uint16_t left = led_matrix_games_scroller_tile(scroller, 0);
+
+    scroller->x++;
+    uint32_t x = scroller->x + LED_MATRIX_WIDTH - 1;
+    scroller->columns[x & RING_MASK] = scroller->gen(scroller->arg, x);
+
+    return left;
+}
+
+unsigned led_matrix_games_scroller_rows(uint16_t tile, int yshift)
+{
+    uint32_t rows;
+
+    if (yshift >= 0) {
+        if (yshift > 15) {
+            yshift = 15;
+        }
+        /* repeat the bottom row of the tile below it */
+        rows = (tile & 0x8000) ? (tile | 0xffff0000) : tile;
+        rows >>= yshift;
+    }
+    else {
+        if (yshift < -(int)LED_MATRIX_HEIGHT) {
+            yshift = -(int)LED_MATRIX_HEIGHT;
+        }
+        /* repeat the top row of the tile above it */
+        rows = (uint32_t)tile << -yshift;
+        if (tile & 0x1) {
+            rows |= (1U << -yshift) - 1;
+        }
+    }
+
+    return rows & SCREEN_MASK;
+}
+
+void led_matrix_games_scroller_draw(const led_matrix_games_scroller_t *scroller,
+                                    int yshift, uint8_t brightness)
+{
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        uint16_t tile = led_matrix_games_scroller_tile(scroller, x);
+        led_matrix_fb_column(x, led_matrix_games_scroller_rows(tile, yshift), brightness);
+    }
+}
+
+void led_matrix_games_scroller_bitboard(const led_matrix_games_scroller_t *scroller,
+                                        int yshift, led_matrix_bitboard_t *bb)
+{
+    for (unsigned x = 0; x < LED_MATRIX_WIDTH; x++) {
+        uint16_t tile = led_matrix_games_scroller_tile(scroller, x);
+        bb->cols[x] = led_matrix_games_scroller_rows(tile, yshift);
+    }
+}
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_led_matrix_tasks  Cooperative Tasks for the LED Matrix
+ * @ingroup     sys
+ *
+ * Module `led_matrix_tasks` runs several activities (scrolling text,
+ * reacting to buttons, animations, game logic) cooperatively in a single
+ * thread, without a stack per activity.
+ *
+ * A task is a function that is called again and again by the scheduler.
+ * The `LED_MATRIX_TASK_*` macros turn it into a protothread: Waiting
+ * returns from the function and the next call resumes right after the wait.
+ * A task can wait for:
+ *
+ * - a frame number (@ref LED_MATRIX_TASK_WAIT_FRAME)
+ * - a button event (@ref LED_MATRIX_TASK_WAIT_BUTTON), optionally with a
+ *   timeout
+ * - a condition, checked once per frame (@ref LED_MATRIX_TASK_WAIT_UNTIL)
+ * - a frame buffer switch (@ref LED_MATRIX_TASK_FB_SWITCH)
+ *
+ * ```C
+ * static int blink(led_matrix_task_t *t)
+ * {
+ *     LED_MATRIX_TASK_BEGIN(t);
+ *     while (1) {
+ *         led_matrix_fb_set(0, 0, LED_MATRIX_BRIGHTNESS_MAX);
+ *         LED_MATRIX_TASK_FB_SWITCH(t, led_matrix_frame_number(), NULL);
+ *         LED_MATRIX_TASK_WAIT_FRAMES(t, 30);
+ *         led_matrix_fb_clear();
+ *         LED_MATRIX_TASK_FB_SWITCH(t, led_matrix_frame_number(), NULL);
+ *         LED_MATRIX_TASK_WAIT_FRAMES(t, 30);
+ *     }
+ *     LED_MATRIX_TASK_END(t);
+ * }
+ * ```
+ *
+ * The scheduler (@ref led_matrix_tasks_run) hands every button event to all
+ * tasks waiting for it right away and resumes the tasks waiting for frames
+ * whenever the frame counter advances. Events no task is waiting for are
+ * dropped.
+ *
+ * The usual limitations of protothreads apply:
+ *
+ * - Local variables are lost while waiting, state to keep needs to live in
+ *   a structure embedding the @ref led_matrix_task_t (see
+ *   @ref container_of) or in static variables
+ * - Waiting is only possible in the task function itself, not in functions
+ *   called by it
+ * - No `switch` statement may enclose a wait
+ * - Only a single wait per source line
+ *
+ * Tasks may still call blocking functions, but this stalls all other
+ * tasks. The frame buffers are shared, so only one task should draw at a
+ * time.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `led_matrix_tasks` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_TASKS_H
+#define LED_MATRIX_TASKS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bitmap_fonts.h"
+#include "button_matrix_events.h"
+#include "container.h"
+#include "led_matrix.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Return values of task functions
+ * @{
+ */
+#define LED_MATRIX_TASK_WAITING     0   /**< Task waits to be resumed */
+#define LED_MATRIX_TASK_EXITED      1   /**< Task is done */
+/** @} */
+
+/**
+ * @name    What a task waits for, or was resumed by
+ * @{
+ */
+#define LED_MATRIX_TASK_WAKE_FRAME  0x1U    /**< Frame number reached */
+#define LED_MATRIX_TASK_WAKE_BUTTON 0x2U    /**< Button event */
+/** @} */
+
+/**
+ * @brief   A cooperative task
+ */
+typedef struct led_matrix_task led_matrix_task_t;
+
+/**
+ * @brief   Signature of task functions
+ *
+ * @param[in,out]   task    The task being run
+ *
+ * @return  @ref LED_MATRIX_TASK_WAITING or @ref LED_MATRIX_TASK_EXITED,
+ *          as returned by the `LED_MATRIX_TASK_*` macros
+ */
+typedef int (*led_matrix_task_fn_t)(led_matrix_task_t *task);
+
+/**
+ * @brief   A cooperative task
+ *
+ * @note    All members are private, except for @ref led_matrix_task::event
+ *          and @ref led_matrix_task::arg
+ */
+struct led_matrix_task {
+    led_matrix_task_t *next;        /**< Next task of the scheduler */
+    led_matrix_task_fn_t fn;        /**< Function implementing the task */
+    void *arg;                      /**< Argument for use by the task */
+    const uint8_t *btn_filter;      /**< Buttons to wake up for, or NULL for all */
+    button_matrix_event_t event;    /**< The last button event received */
+    uint32_t wake_at;               /**< Frame number to wake up at */
+    uint16_t lc;                    /**< Line to resume at */
+    uint8_t wait;                   /**< What the task waits for, or was woken by */
+    bool queued;                    /**< Task is in the list of the scheduler */
+};
+
+/**
+ * @brief   Start of the body of a task function
+ */
+#define LED_MATRIX_TASK_BEGIN(t)                                            \
+    switch ((t)->lc) {                                                      \
+    case 0:
+
+/**
+ * @brief   End of the body of a task function, exits the task
+ */
+#define LED_MATRIX_TASK_END(t)                                              \
+    }                                                                       \
+    (t)->lc = 0;                                                            \
+    return LED_MATRIX_TASK_EXITED
+
+/**
+ * @brief   Exit the task
+ */
+#define LED_MATRIX_TASK_EXIT(t)                                             \
+    do {                                                                    \
+        (t)->lc = 0;                                                        \
+        return LED_MATRIX_TASK_EXITED;                                      \
+    } while (0)
+
+/**
+ * @brief   Wait for the events given in @p what (internal)
+ */
+#define LED_MATRIX_TASK_WAIT_(t, what)                                      \
+    do {                                                                    \
+        (t)->wait = (what);                                                 \
+        (t)->lc = __LINE__;                                                 \
+        return LED_MATRIX_TASK_WAITING;                                     \
+    case __LINE__:;                                                         \
+    } while (0)
+
+/**
+ * @brief   Wait until the frame with the given number is shown
+ *
+ * @pre     @p frame is no more than `UINT16_MAX` frames in the future
+ */
+#define LED_MATRIX_TASK_WAIT_FRAME(t, frame)                                \
+    do {                                                                    \
+        (t)->wake_at = (frame);                                             \
+        LED_MATRIX_TASK_WAIT_(t, LED_MATRIX_TASK_WAKE_FRAME);               \
+    } while (0)
+
+/**
+ * @brief   Wait for the given number of frames
+ */
+#define LED_MATRIX_TASK_WAIT_FRAMES(t, n)                                   \
+    LED_MATRIX_TASK_WAIT_FRAME(t, led_matrix_frame_number() + (n))
+
+/**
+ * @brief   Wait for an event of one of the buttons in @p filter
+ *
+ * @param[in,out]   t       The task
+ * @param[in]       filter  Bit vector of the buttons to wait for (in the
+ *                          format of @ref button_matrix_scan), or `NULL` for
+ *                          all. Must stay valid while waiting.
+ *
+ * The event is stored in @ref led_matrix_task::event.
+ */
+#define LED_MATRIX_TASK_WAIT_BUTTON(t, filter)                              \
+    do {                                                                    \
+        (t)->btn_filter = (filter);                                         \
+        LED_MATRIX_TASK_WAIT_(t, LED_MATRIX_TASK_WAKE_BUTTON);              \
+    } while (0)
+
+/**
+ * @brief   Wait for an event of one of the buttons in @p filter, but no
+ *          longer than until the given frame number
+ *
+ * Use @ref led_matrix_task_woken_by_button to tell the two apart.
+ */
+#define LED_MATRIX_TASK_WAIT_BUTTON_UNTIL(t, filter, frame)                 \
+    do {                                                                    \
+        (t)->btn_filter = (filter);                                         \
+        (t)->wake_at = (frame);                                             \
+        LED_MATRIX_TASK_WAIT_(t, LED_MATRIX_TASK_WAKE_BUTTON                \
+                                 | LED_MATRIX_TASK_WAKE_FRAME);             \
+    } while (0)
+
+/**
+ * @brief   Wait until @p cond is true, checking it once per frame
+ */
+#define LED_MATRIX_TASK_WAIT_UNTIL(t, cond)                                 \
+    do {                                                                    \
+        (t)->lc = __LINE__;                                                 \
+        __attribute__((fallthrough));                                       \
+    case __LINE__:                                                          \
+        if (!(cond)) {                                                      \
+            (t)->wake_at = led_matrix_frame_number() + 1;                   \
+            (t)->wait = LED_MATRIX_TASK_WAKE_FRAME;                         \
+            return LED_MATRIX_TASK_WAITING;                                 \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief   Switch the frame buffers at the given frame and wait until they
+ *          have been switched
+ *
+ * @param[in,out]   t       The task
+ * @param[in]       frame   Frame number to switch at, as in
+ *                          @ref led_matrix_fb_switch
+ * @param[out]      shown   The frame number the switch happened at, may be
+ *                          `NULL`
+ */
+#define LED_MATRIX_TASK_FB_SWITCH(t, frame, shown)                          \
+    do {                                                                    \
+        led_matrix_fb_switch_request(frame);                                \
+        LED_MATRIX_TASK_WAIT_UNTIL(t, led_matrix_fb_switch_done(shown));    \
+    } while (0)
+
+/**
+ * @brief   Check if the last wait of the task ended due to a button event
+ */
+static inline bool led_matrix_task_woken_by_button(const led_matrix_task_t *t)
+{
+    return t->wait == LED_MATRIX_TASK_WAKE_BUTTON;
+}
+
+/**
+ * @brief   Add a task to the scheduler and run it from the start
+ *
+ * @param[out]  task    The task to start
+ * @param[in]   fn      The function implementing the task
+ * @param[in]   arg     Argument for use by the task
+ *
+ * If @p task is already running, it is restarted. The task first runs
+ * from within @ref led_matrix_tasks_run.
+ */
+void led_matrix_task_start(led_matrix_task_t *task, led_matrix_task_fn_t fn, void *arg);
+
+/**
+ * @brief   Stop the given task
+ *
+ * @param[in,out]   task    The task to stop
+ *
+ * Stopping a task that is not running is a no-op. A task may stop itself,
+ * but using @ref LED_MATRIX_TASK_EXIT is more natural.
+ *
+ * @note    A frame buffer switch requested by the stopped task (e.g. via
+ *          @ref LED_MATRIX_TASK_FB_SWITCH) may still be pending. Wait for
+ *          @ref led_matrix_fb_switch_done before drawing.
+ */
+void led_matrix_task_stop(led_matrix_task_t *task);
+
+/**
+ * @brief   Check if the given task is running
+ */
+static inline bool led_matrix_task_is_running(const led_matrix_task_t *task)
+{
+    return task->wait != 0;
+}
+
+/**
+ * @brief   Run the tasks started until all of them exited
+ *
+ * The calling thread busy waits while no task is ready, just like
+ * @ref led_matrix_wait_for_frame does.
+ *
+ * @warning Only a single thread may run the scheduler.
+ */
+void led_matrix_tasks_run(void);
+
+/**
+ * @brief   A task scrolling text in a loop
+ *
+ * The state of the scroll is kept here, so that any number of these tasks
+ * can be used without any additional stack.
+ */
+typedef struct {
+    led_matrix_task_t task;         /**< The task scrolling the text */
+    const bitmap_font_t *font;      /**< Font to render the text in */
+    const char *text;               /**< Text to scroll */
+    size_t len;                     /**< Length of text */
+    int width;                      /**< Width of the rendered text */
+    int xshift;                     /**< Current horizontal offset */
+    uint32_t frame;                 /**< Frame number the last column was shown at */
+    uint8_t brightness;             /**< Brightness to render the text with */
+} led_matrix_tasks_scroll_t;
+
+/**
+ * @brief   Start a task that scrolls the given text in a loop, like
+ *          @ref led_matrix_text_scroll_until_button does
+ *
+ * @param[out]  scroll      The task to start
+ * @param[in]   font        The font to render the text in
+ * @param[in]   text        The text to scroll, must stay valid while the
+ *                          task is running
+ * @param[in]   len         Length of @p text
+ * @param[in]   brightness  The brightness to render the text with
+ *
+ * If @p scroll is already running, it restarts with the new text. Stop it
+ * with @ref led_matrix_task_stop on `scroll->task`.
+ */
+void led_matrix_tasks_scroll(led_matrix_tasks_scroll_t *scroll, const bitmap_font_t *font,
+                             const char *text, size_t len, uint8_t brightness);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_TASKS_H */
+/** @} */
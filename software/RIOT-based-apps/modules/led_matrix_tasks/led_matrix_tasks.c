@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_tasks
+ * @{
+ *
+ * @file
+ * @brief       Scheduler of cooperative tasks for the LED matrix
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "button_matrix_events.h"
+#include "led_matrix.h"
+#include "led_matrix_params.h"
+#include "led_matrix_tasks.h"
+
+/* frames to show every column of scrolling text for, same as
+ * led_matrix_text_scroll() */
+#define SCROLL_FRAMES   4
+
+static led_matrix_task_t *tasks;
+
+void led_matrix_task_start(led_matrix_task_t *task, led_matrix_task_fn_t fn, void *arg)
+{
+    assert((task != NULL) && (fn != NULL));
+
+    task->fn = fn;
+    task->arg = arg;
+    task->lc = 0;
+    task->wake_at = led_matrix_frame_number();
+    task->wait = LED_MATRIX_TASK_WAKE_FRAME;
+
+    if (!task->queued) {
+        task->queued = true;
+        task->next = tasks;
+        tasks = task;
+    }
+}
+
+void led_matrix_task_stop(led_matrix_task_t *task)
+{
+    /* the task is removed from the list by the scheduler, as it may be
+     * iterating over it right now */
+    task->wait = 0;
+}
+
+static void resume(led_matrix_task_t *task, uint8_t reason)
+{
+    task->wait = reason;
+    if (task->fn(task) == LED_MATRIX_TASK_EXITED) {
+        task->wait = 0;
+    }
+}
+
+static bool frame_reached(uint32_t now, uint32_t frame)
+{
+    return (now - frame) <= UINT16_MAX;
+}
+
+static bool wants_event(const led_matrix_task_t *task, const button_matrix_event_t *event)
+{
+    if (!(task->wait & LED_MATRIX_TASK_WAKE_BUTTON)) {
+        return false;
+    }
+
+    return !task->btn_filter
+           || (task->btn_filter[event->button >> 3] & (1U << (event->button & 0x7)));
+}
+
+static bool dispatch_events(void)
+{
+    bool ran = false;
+    button_matrix_event_t event;
+
+    while (button_matrix_events_try_get(&event)) {
+        for (led_matrix_task_t *t = tasks; t; t = t->next) {
+            if (wants_event(t, &event)) {
+                t->event = event;
+                resume(t, LED_MATRIX_TASK_WAKE_BUTTON);
+                ran = true;
+            }
+        }
+    }
+
+    return ran;
+}
+
+static bool dispatch_frame(uint32_t now)
+{
+    bool ran = false;
+
+    for (led_matrix_task_t *t = tasks; t; t = t->next) {
+        if ((t->wait & LED_MATRIX_TASK_WAKE_FRAME) && frame_reached(now, t->wake_at)) {
+            resume(t, LED_MATRIX_TASK_WAKE_FRAME);
+            ran = true;
+        }
+    }
+
+    return ran;
+}
+
+static void remove_stopped(void)
+{
+    led_matrix_task_t **pos = &tasks;
+
+    while (*pos) {
+        led_matrix_task_t *t = *pos;
+        if (t->wait) {
+            pos = &t->next;
+        }
+        else {
+            t->queued = false;
+            *pos = t->next;
+        }
+    }
+}
+
+static void idle(uint32_t now)
+{
+#if MODULE_LED_MATRIX_HEADLESS
+    /* time only advances while waiting for it, and button events are only
+     * generated along with the frames */
+    led_matrix_wait_for_frame(now + 1);
+#else
+    while ((led_matrix_frame_number() == now) && !button_matrix_events_pending()) {
+        /* busy wait */
+    }
+#endif
+}
+
+void led_matrix_tasks_run(void)
+{
+    while (1) {
+        uint32_t now = led_matrix_frame_number();
+
+        /* tasks started or woken up for the current frame by the tasks
+         * that ran get their turn before idling */
+        bool ran = dispatch_events();
+        ran |= dispatch_frame(now);
+
+        remove_stopped();
+        if (!tasks) {
+            return;
+        }
+
+        if (!ran) {
+            idle(now);
+        }
+    }
+}
+
+static int scroll_task(led_matrix_task_t *t)
+{
+    led_matrix_tasks_scroll_t *s = container_of(t, led_matrix_tasks_scroll_t, task);
+
+    LED_MATRIX_TASK_BEGIN(t);
+    s->frame = led_matrix_frame_number();
+    while (1) {
+        for (s->xshift = LED_MATRIX_WIDTH - 1; s->xshift > -s->width - 1; s->xshift--) {
+            led_matrix_fb_clear();
+            led_matrix_text(s->font, s->text, s->len, s->xshift,
+                            ((int)LED_MATRIX_HEIGHT - s->font->height + 1) / 2, s->brightness);
+            LED_MATRIX_TASK_FB_SWITCH(t, s->frame, &s->frame);
+            s->frame += SCROLL_FRAMES;
+        }
+    }
+    LED_MATRIX_TASK_END(t);
+}
+
+void led_matrix_tasks_scroll(led_matrix_tasks_scroll_t *scroll, const bitmap_font_t *font,
+                             const char *text, size_t len, uint8_t brightness)
+{
+    assert((font != NULL) && (text != NULL));
+
+    scroll->font = font;
+    scroll->text = text;
+    scroll->len = len;
+    scroll->width = bitmap_font_render_width(font, text, len);
+    scroll->brightness = brightness;
+    led_matrix_task_start(&scroll->task, scroll_task, NULL);
+}
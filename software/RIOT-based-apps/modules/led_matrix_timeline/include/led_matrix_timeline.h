@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_led_matrix_timeline  Tweens on a Timeline of Frames
+ * @ingroup     sys
+ *
+ * Module `led_matrix_timeline` animates values such as positions,
+ * brightness levels, or scroll offsets frame by frame, without blocking the
+ * thread for the duration of the animation.
+ *
+ * A tween moves a value from a start to an end value over a number of
+ * frames, following an easing curve. Tweens are scheduled on a timeline to
+ * start at a given frame number. The timeline is advanced once per frame
+ * with @ref led_matrix_timeline_advance, which updates the values of all
+ * tweens running at that frame, so any number of animations run
+ * concurrently in the thread calling it. Rendering the values is up to the
+ * caller.
+ *
+ * ```C
+ * led_matrix_timeline_t timeline = { 0 };
+ * int16_t brightness;
+ * led_matrix_tween_t fade_in = {
+ *     .value = &brightness,
+ *     .from = 0,
+ *     .to = LED_MATRIX_BRIGHTNESS_MAX,
+ *     .duration = 30,
+ *     .ease = LED_MATRIX_EASE_OUT,
+ * };
+ * uint32_t frame = led_matrix_frame_number();
+ *
+ * led_matrix_timeline_add(&timeline, &fade_in, frame);
+ * while (!led_matrix_timeline_done(&timeline)) {
+ *     if (led_matrix_timeline_advance(&timeline, frame)) {
+ *         led_matrix_fb_clear();
+ *         led_matrix_fb_set(0, 0, brightness);
+ *         led_matrix_fb_switch(frame);
+ *     }
+ *     // game logic running along goes here
+ *     frame++;
+ * }
+ * ```
+ *
+ * @ref led_matrix_timeline_play does the same without the game logic.
+ *
+ * The cost of advancing the timeline is bounded by the number of tweens
+ * scheduled: The progress of a tween is a multiplication with the
+ * reciprocal of its duration, computed once when scheduling it, as the
+ * Cortex-M0+ has no hardware divider. The easing curves are quadratic
+ * polynomials in fixed point.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `led_matrix_timeline` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef LED_MATRIX_TIMELINE_H
+#define LED_MATRIX_TIMELINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Value of @ref led_matrix_tween::repeat to repeat forever
+ */
+#define LED_MATRIX_TWEEN_REPEAT_FOREVER     UINT8_MAX
+
+/**
+ * @brief   Easing curves
+ */
+typedef enum {
+    LED_MATRIX_EASE_LINEAR,     /**< Constant speed */
+    LED_MATRIX_EASE_IN,         /**< Accelerating from zero speed */
+    LED_MATRIX_EASE_OUT,        /**< Decelerating to zero speed */
+    LED_MATRIX_EASE_IN_OUT,     /**< Accelerating until half way, then decelerating */
+    LED_MATRIX_EASE_STEP,       /**< Jump from start to end value half way */
+} led_matrix_ease_t;
+
+/**
+ * @brief   A tween
+ */
+typedef struct led_matrix_tween led_matrix_tween_t;
+
+/**
+ * @brief   A tween
+ *
+ * The members up to @ref led_matrix_tween::yoyo are set by the user before
+ * scheduling the tween, the others are private.
+ */
+struct led_matrix_tween {
+    int16_t *value;             /**< The value to animate */
+    int16_t from;               /**< Value at the start */
+    int16_t to;                 /**< Value at the end */
+    /**
+     * @brief   Duration in frames
+     *
+     * With a duration of zero, the value jumps to @ref led_matrix_tween::to
+     * at the start frame, which makes a keyframe.
+     */
+    uint16_t duration;
+    uint8_t ease;               /**< Easing curve, see @ref led_matrix_ease_t */
+    /**
+     * @brief   Number of times to run again after the first time, or
+     *          @ref LED_MATRIX_TWEEN_REPEAT_FOREVER
+     */
+    uint8_t repeat;
+    bool yoyo;                  /**< Run back from @ref led_matrix_tween::to on every repetition */
+    led_matrix_tween_t *next;   /**< Next tween on the timeline */
+    uint32_t start;             /**< Frame number the current run started at */
+    uint32_t step;              /**< Progress per frame in 1/65536 */
+};
+
+/**
+ * @brief   A timeline
+ *
+ * Zero-initialize before use.
+ */
+typedef struct {
+    led_matrix_tween_t *tweens;     /**< Tweens scheduled, in order */
+} led_matrix_timeline_t;
+
+/**
+ * @brief   Schedule a tween
+ *
+ * @param[in,out]   timeline    The timeline to schedule the tween on
+ * @param[in,out]   tween       The tween to schedule
+ * @param[in]       start       Frame number to start the tween at
+ *
+ * The value is not touched before @p start. If several running tweens
+ * animate the same value, the one added last wins.
+ *
+ * @pre     @p tween is not scheduled already, and stays valid until it is
+ *          done or removed
+ * @pre     @p start is no more than `INT32_MAX` frames in the future
+ */
+void led_matrix_timeline_add(led_matrix_timeline_t *timeline, led_matrix_tween_t *tween,
+                             uint32_t start);
+
+/**
+ * @brief   Remove a tween before it is done, leaving the value as is
+ *
+ * @param[in,out]   timeline    The timeline the tween is scheduled on
+ * @param[in]       tween       The tween to remove
+ */
+void led_matrix_timeline_remove(led_matrix_timeline_t *timeline, const led_matrix_tween_t *tween);
+
+/**
+ * @brief   Update the values of all tweens for the given frame
+ *
+ * @param[in,out]   timeline    The timeline to advance
+ * @param[in]       frame       The frame number to compute the values for
+ *
+ * Tweens that are done set their end value and are removed from the
+ * timeline. Frames may be skipped, e.g. when the caller falls behind,
+ * but must not go backwards.
+ *
+ * @retval  true    At least one value changed
+ * @retval  false   No value changed, the last frame can be shown again
+ */
+bool led_matrix_timeline_advance(led_matrix_timeline_t *timeline, uint32_t frame);
+
+/**
+ * @brief   Check if all tweens on the timeline are done
+ */
+static inline bool led_matrix_timeline_done(const led_matrix_timeline_t *timeline)
+{
+    return timeline->tweens == NULL;
+}
+
+/**
+ * @brief   Advance the timeline until all tweens are done, rendering
+ *          every change
+ *
+ * @param[in,out]   timeline    The timeline to play
+ * @param[in]       frame       The frame number to start at
+ * @param[in]       render      Function rendering the values into the
+ *                              scratch frame buffer
+ * @param[in]       arg         Argument to pass to @p render
+ *
+ * The first frame is always rendered. Every frame rendered is passed to
+ * @ref led_matrix_fb_switch with its frame number on the timeline, so it
+ * shows up one frame later, as documented there. If
+ * @p frame has passed already, all tweens are delayed to start at the
+ * current frame instead.
+ *
+ * @return  The frame number at which the last tween was done
+ *
+ * @warning None of the tweens may repeat forever
+ */
+uint32_t led_matrix_timeline_play(led_matrix_timeline_t *timeline, uint32_t frame,
+                                  void (*render)(void *arg), void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_MATRIX_TIMELINE_H */
+/** @} */
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_led_matrix_timeline
+ * @{
+ *
+ * @file
+ * @brief       Tweens on a timeline of frames
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "led_matrix.h"
+#include "led_matrix_timeline.h"
+
+/* progress of a tween in 1/256 */
+#define PROGRESS_END    256
+
+void led_matrix_timeline_add(led_matrix_timeline_t *timeline, led_matrix_tween_t *tween,
+                             uint32_t start)
+{
+    assert(tween->value != NULL);
+    assert(tween->duration || (tween->repeat == 0));
+
+    tween->start = start;
+    tween->next = NULL;
+    /* rounded up, so that the progress reaches half way after half the
+     * duration. This is the only division */
+    tween->step = tween->duration ? (65536U + tween->duration - 1) / tween->duration : 0;
+
+    led_matrix_tween_t **tail = &timeline->tweens;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = tween;
+}
+
+void led_matrix_timeline_remove(led_matrix_timeline_t *timeline, const led_matrix_tween_t *tween)
+{
+    for (led_matrix_tween_t **pos = &timeline->tweens; *pos; pos = &(*pos)->next) {
+        if (*pos == tween) {
+            *pos = tween->next;
+            return;
+        }
+    }
+}
+
+static unsigned ease(unsigned ease, unsigned p)
+{
+    unsigned q = PROGRESS_END - p;
+
+    switch (ease) {
+    default:
+    case LED_MATRIX_EASE_LINEAR:
+        return p;
+    case LED_MATRIX_EASE_IN:
+        return (p * p) >> 8;
+    case LED_MATRIX_EASE_OUT:
+        return PROGRESS_END - ((q * q) >> 8);
+    case LED_MATRIX_EASE_IN_OUT:
+        return (p < PROGRESS_END / 2) ? (p * p) >> 7 : PROGRESS_END - ((q * q) >> 7);
+    case LED_MATRIX_EASE_STEP:
+        return (p < PROGRESS_END / 2) ? 0 : PROGRESS_END;
+    }
+}
+
+/* returns false once the tween is done */
+static bool tween_advance(led_matrix_tween_t *tween, uint32_t frame, int16_t *value)
+{
+    uint32_t elapsed = frame - tween->start;
+
+    /* start the next runs, more than one if frames have been skipped */
+    while (elapsed >= tween->duration) {
+        if (tween->repeat == 0) {
+            *value = tween->to;
+            return false;
+        }
+
+        if (tween->repeat != LED_MATRIX_TWEEN_REPEAT_FOREVER) {
+            tween->repeat--;
+        }
+        if (tween->yoyo) {
+            int16_t tmp = tween->from;
+            tween->from = tween->to;
+            tween->to = tmp;
+        }
+        tween->start += tween->duration;
+        elapsed -= tween->duration;
+    }
+
+    unsigned p = (elapsed * tween->step) >> 8;
+    if (p > PROGRESS_END) {
+        p = PROGRESS_END;
+    }
+
+    int diff = tween->to - tween->from;
+    *value = tween->from + ((diff * (int)ease(tween->ease, p)) >> 8);
+    return true;
+}
+
+bool led_matrix_timeline_advance(led_matrix_timeline_t *timeline, uint32_t frame)
+{
+    bool changed = false;
+    led_matrix_tween_t **pos = &timeline->tweens;
+
+    while (*pos) {
+        led_matrix_tween_t *tween = *pos;
+
+        if ((int32_t)(frame - tween->start) < 0) {
+            /* not started yet */
+            pos = &tween->next;
+            continue;
+        }
+
+        int16_t value;
+        bool running = tween_advance(tween, frame, &value);
+
+        if (*tween->value != value) {
+            *tween->value = value;
+            changed = true;
+        }
+
+        if (running) {
+            pos = &tween->next;
+        }
+        else {
+            *pos = tween->next;
+        }
+    }
+
+    return changed;
+}
+
+uint32_t led_matrix_timeline_play(led_matrix_timeline_t *timeline, uint32_t frame,
+                                  void (*render)(void *arg), void *arg)
+{
+    bool first = true;
+    uint32_t now = led_matrix_frame_number();
+
+    if ((int32_t)(frame - now) < 0) {
+        /* too late to start at the given frame, so delay all tweens instead
+         * of skipping their start */
+        for (led_matrix_tween_t *tween = timeline->tweens; tween; tween = tween->next) {
+            tween->start += now - frame;
+        }
+        frame = now;
+    }
+
+    while (1) {
+        bool changed = led_matrix_timeline_advance(timeline, frame);
+
+        if (changed || first) {
+            render(arg);
+            led_matrix_fb_switch(frame);
+            first = false;
+        }
+
+        if (led_matrix_timeline_done(timeline)) {
+            return frame;
+        }
+
+        frame++;
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_stdio_fb  STDIO over the LED Matrix
+ * @ingroup     sys
+ *
+ * Module `stdio_fb` scrolls everything written to stdout over the LED
+ * matrix, one line at a time.
+ *
+ * Writing does not wait for the animation: The output is appended to a ring
+ * buffer of @ref CONFIG_STDIO_FB_BUF_SIZE bytes and the write returns
+ * right away. A thread of low priority (@ref CONFIG_STDIO_FB_PRIO) takes
+ * the output out of the buffer line by line and scrolls it. What happens if
+ * the buffer is full is configured by @ref CONFIG_STDIO_FB_OVERFLOW.
+ *
+ * Writing from ISR context is supported, but never blocks: With
+ * @ref STDIO_FB_OVERFLOW_BLOCK, output from ISRs that does not fit is
+ * dropped. For diagnostics from ISRs, @ref sys_stdio_fb_log is a lot
+ * cheaper than formatting output with `printf()`.
+ *
+ * The console watches the backlog of output not yet shown, so that it stays
+ * close to real time even under bursts of output:
+ *
+ * - Scrolling speeds up by one frame per column for every
+ *   @ref CONFIG_STDIO_FB_BACKLOG_STEP bytes of backlog, from
+ *   @ref CONFIG_STDIO_FB_SCROLL_FRAMES down to
+ *   @ref CONFIG_STDIO_FB_SCROLL_FRAMES_MIN frames per column
+ * - Consecutive identical lines are shown only once, followed by the
+ *   number of repetitions (@ref CONFIG_STDIO_FB_MERGE_REPEATS)
+ * - Once the backlog reaches @ref CONFIG_STDIO_FB_BACKLOG_SKIP bytes, the
+ *   line being shown is cut short and the oldest lines are skipped until
+ *   half of that is left. The number of lines skipped is shown instead.
+ *
+ * None of this needs memory beyond the output buffer and a line buffer.
+ * Together with one of the dropping overflow policies, the application
+ * never waits for the display.
+ *
+ * @note    The scroller thread only runs when all threads of higher
+ *          priority are blocked. An application busy waiting for frames
+ *          (e.g. using @ref led_matrix_fb_switch) holds back the output
+ *          until it blocks.
+ *
+ * @warning The scroller thread draws to the framebuffer of the LED matrix.
+ *          Applications drawing to it as well will have their content
+ *          overwritten while output is shown.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `stdio_fb` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef STDIO_FB_H
+#define STDIO_FB_H
+
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Overflow policies
+ * @{
+ */
+/**
+ * @brief   Drop the output that does not fit into the buffer anymore
+ *
+ * The cheapest policy, but lines may be cut off at the end.
+ */
+#define STDIO_FB_OVERFLOW_DROP_NEW      0
+/**
+ * @brief   Drop the oldest lines not yet shown to make room
+ *
+ * The display shows the most recent output, at the cost of dropping more
+ * than needed (only whole lines are dropped).
+ */
+#define STDIO_FB_OVERFLOW_DROP_OLD      1
+/**
+ * @brief   Block the writer until the scroller made room for the output
+ *
+ * This is the behavior of an unbuffered console. Writers in ISR context
+ * fall back to @ref STDIO_FB_OVERFLOW_DROP_NEW.
+ */
+#define STDIO_FB_OVERFLOW_BLOCK         2
+/** @} */
+
+/**
+ * @brief   Size of the output buffer in bytes (must be a power of two)
+ */
+#ifndef CONFIG_STDIO_FB_BUF_SIZE
+#  define CONFIG_STDIO_FB_BUF_SIZE      64
+#endif
+
+/**
+ * @brief   Longest line scrolled at once
+ *
+ * Longer lines are split into several ones.
+ */
+#ifndef CONFIG_STDIO_FB_LINE_MAX
+#  define CONFIG_STDIO_FB_LINE_MAX      32
+#endif
+
+/**
+ * @brief   Frames to show every column for while there is no backlog
+ */
+#ifndef CONFIG_STDIO_FB_SCROLL_FRAMES
+#  define CONFIG_STDIO_FB_SCROLL_FRAMES     4
+#endif
+
+/**
+ * @brief   Frames to show every column for at least, however high the
+ *          backlog is
+ */
+#ifndef CONFIG_STDIO_FB_SCROLL_FRAMES_MIN
+#  define CONFIG_STDIO_FB_SCROLL_FRAMES_MIN 1
+#endif
+
+/**
+ * @brief   Bytes of backlog that speed up scrolling by one frame per column
+ *
+ * Set to 0 to always scroll at @ref CONFIG_STDIO_FB_SCROLL_FRAMES.
+ */
+#ifndef CONFIG_STDIO_FB_BACKLOG_STEP
+#  define CONFIG_STDIO_FB_BACKLOG_STEP      (CONFIG_STDIO_FB_BUF_SIZE / 8)
+#endif
+
+/**
+ * @brief   Backlog in bytes at which old lines are skipped
+ *
+ * Set to 0 to never skip lines.
+ */
+#ifndef CONFIG_STDIO_FB_BACKLOG_SKIP
+#  define CONFIG_STDIO_FB_BACKLOG_SKIP      (CONFIG_STDIO_FB_BUF_SIZE * 3 / 4)
+#endif
+
+/**
+ * @brief   Show consecutive identical lines only once with the number of
+ *          repetitions
+ */
+#ifndef CONFIG_STDIO_FB_MERGE_REPEATS
+#  define CONFIG_STDIO_FB_MERGE_REPEATS     1
+#endif
+
+/**
+ * @brief   What to do when the output buffer is full
+ */
+#ifndef CONFIG_STDIO_FB_OVERFLOW
+#  define CONFIG_STDIO_FB_OVERFLOW      STDIO_FB_OVERFLOW_DROP_NEW
+#endif
+
+/**
+ * @brief   Priority of the scroller thread
+ */
+#ifndef CONFIG_STDIO_FB_PRIO
+#  define CONFIG_STDIO_FB_PRIO          (THREAD_PRIORITY_MIN - 1)
+#endif
+
+/**
+ * @brief   Stack size of the scroller thread
+ */
+#ifndef CONFIG_STDIO_FB_STACKSIZE
+#  define CONFIG_STDIO_FB_STACKSIZE     THREAD_STACKSIZE_SMALL
+#endif
+
+/**
+ * @brief   Block until all output written so far has been shown
+ *
+ * @pre     Not called from ISR context
+ */
+void stdio_fb_flush(void);
+
+/**
+ * @brief   Wake up the scroller thread to show new output
+ *
+ * @note    Called internally when output or log entries were added
+ */
+void stdio_fb_notify(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STDIO_FB_H */
+/** @} */
@@ -7,7 +7,7 @@
  */
 
 /**
- * @ingroup     sys
+ * @ingroup     sys_stdio_fb
  * @{
  *
  * @file
@@ -20,10 +20,23 @@
  * @}
  */
 
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
 #include "bitmap_fonts.h"
+#include "fmt.h"
 #include "irq.h"
 #include "led_matrix.h"
+#include "mutex.h"
 #include "stdio_base.h"
+#include "stdio_fb.h"
+#include "thread.h"
+#include "tsrb.h"
+
+#if MODULE_STDIO_FB_LOG
+#include "stdio_fb_log.h"
+#endif
 
 #ifndef STDIO_LED_MATRIX_FONT
 #  define STDIO_LED_MATRIX_FONT &bitmap_font_matrix_light8
@@ -33,39 +46,303 @@
 #  define STDIO_LED_MATRIX_BRIGHTNESS   LED_MATRIX_BRIGHTNESS_MAX
 #endif
 
+/* longest decimal representation of a uint32_t */
+#define U32_DEC_MAXLEN  10
+
+static_assert((CONFIG_STDIO_FB_BUF_SIZE & (CONFIG_STDIO_FB_BUF_SIZE - 1)) == 0,
+              "CONFIG_STDIO_FB_BUF_SIZE must be a power of two");
+static_assert((CONFIG_STDIO_FB_SCROLL_FRAMES_MIN > 0)
+              && (CONFIG_STDIO_FB_SCROLL_FRAMES_MIN <= CONFIG_STDIO_FB_SCROLL_FRAMES),
+              "CONFIG_STDIO_FB_SCROLL_FRAMES_MIN must be in [1, CONFIG_STDIO_FB_SCROLL_FRAMES]");
+
+static uint8_t buf[CONFIG_STDIO_FB_BUF_SIZE];
+static tsrb_t rb = TSRB_INIT(buf);
+/* room for a line plus " x<repetitions>" */
+static char line[CONFIG_STDIO_FB_LINE_MAX + 2 + U32_DEC_MAXLEN];
+#if CONFIG_STDIO_FB_MERGE_REPEATS
+static uint8_t next_line[CONFIG_STDIO_FB_LINE_MAX + 1];
+#endif
+static char stack[CONFIG_STDIO_FB_STACKSIZE];
+static bool scrolling;
+
+/* the mutexes are used as signals: data_signal is unlocked whenever output
+ * was added, space_signal whenever output was taken out, and idle_signal
+ * when all output has been shown */
+static mutex_t data_signal = MUTEX_INIT_LOCKED;
+static mutex_t idle_signal = MUTEX_INIT_LOCKED;
+#if CONFIG_STDIO_FB_OVERFLOW == STDIO_FB_OVERFLOW_BLOCK
+static mutex_t space_signal = MUTEX_INIT_LOCKED;
+#endif
+
+void stdio_fb_notify(void)
+{
+    mutex_unlock(&data_signal);
+}
+
+static bool pending(void)
+{
+#if MODULE_STDIO_FB_LOG
+    if (stdio_fb_log_pending()) {
+        return true;
+    }
+#endif
+    return !tsrb_empty(&rb);
+}
+
+static size_t format_entry(const char *msg, uint32_t arg)
+{
+    size_t len = strnlen(msg, CONFIG_STDIO_FB_LINE_MAX);
+    memcpy(line, msg, len);
+    line[len++] = ' ';
+    return len + fmt_u32_dec(&line[len], arg);
+}
+
+#if MODULE_STDIO_FB_LOG
+/* format the next log entry as line. Entries are only dropped while the log
+ * is full, so the loss is reported after the entries still in the log */
+static size_t take_log_line(void)
+{
+    stdio_fb_log_entry_t entry;
+
+    for (unsigned ctx = 0; ctx < CONFIG_STDIO_FB_LOG_CONTEXTS; ctx++) {
+        if (stdio_fb_log_take(ctx, &entry)) {
+            return format_entry(entry.msg, entry.arg);
+        }
+    }
+
+    for (unsigned ctx = 0; ctx < CONFIG_STDIO_FB_LOG_CONTEXTS; ctx++) {
+        uint32_t dropped = stdio_fb_log_dropped(ctx);
+        if (dropped) {
+            return format_entry("log dropped", dropped);
+        }
+    }
+
+    return 0;
+}
+#endif
+
+/* take the next line out of the buffer, without the newline. complete is
+ * set if the line ended with a newline */
+static size_t take_line(bool *complete)
+{
+    size_t len = 0;
+    int c;
+
+    *complete = false;
+    while ((len < CONFIG_STDIO_FB_LINE_MAX) && ((c = tsrb_get_one(&rb)) >= 0)) {
+        if (c == '\n') {
+            *complete = true;
+            break;
+        }
+        line[len++] = c;
+    }
+
+    return len;
+}
+
+#if CONFIG_STDIO_FB_MERGE_REPEATS
+/* drop the lines waiting that repeat the one of len bytes in line */
+static uint32_t take_repeats(size_t len)
+{
+    uint32_t repeats = 0;
+    unsigned irq_state = irq_disable();
+
+    while ((tsrb_peek(&rb, next_line, len + 1) == (int)(len + 1))
+            && (next_line[len] == '\n') && !memcmp(next_line, line, len)) {
+        tsrb_drop(&rb, len + 1);
+        repeats++;
+    }
+
+    irq_restore(irq_state);
+    return repeats;
+}
+#endif
+
+#if CONFIG_STDIO_FB_BACKLOG_SKIP
+/* drop the oldest lines if the backlog is too high */
+static uint32_t skip_backlog(void)
+{
+    uint32_t skipped = 0;
+    unsigned irq_state = irq_disable();
+
+    if (tsrb_avail(&rb) >= CONFIG_STDIO_FB_BACKLOG_SKIP) {
+        while (tsrb_avail(&rb) > CONFIG_STDIO_FB_BACKLOG_SKIP / 2) {
+            int c;
+            do {
+                c = tsrb_get_one(&rb);
+            } while ((c >= 0) && (c != '\n'));
+            skipped++;
+        }
+    }
+
+    irq_restore(irq_state);
+    return skipped;
+}
+#endif
+
+/* take the next line of regular output, applying the backlog rules */
+static size_t take_output_line(void)
+{
+#if CONFIG_STDIO_FB_BACKLOG_SKIP
+    uint32_t skipped = skip_backlog();
+    if (skipped) {
+        return format_entry("skipped", skipped);
+    }
+#endif
+
+    bool complete;
+    size_t len = take_line(&complete);
+
+#if CONFIG_STDIO_FB_MERGE_REPEATS
+    if (complete && len) {
+        uint32_t repeats = take_repeats(len);
+        if (repeats) {
+            line[len++] = ' ';
+            line[len++] = 'x';
+            len += fmt_u32_dec(&line[len], repeats + 1);
+        }
+    }
+#else
+    (void)complete;
+#endif
+
+    return len;
+}
+
+/* frames per column depending on the backlog, 0 to cut the line short */
+static unsigned scroll_speed(void *arg)
+{
+    (void)arg;
+    unsigned backlog = tsrb_avail(&rb);
+
+#if CONFIG_STDIO_FB_BACKLOG_SKIP
+    if (backlog >= CONFIG_STDIO_FB_BACKLOG_SKIP) {
+        return 0;
+    }
+#endif
+
+#if CONFIG_STDIO_FB_BACKLOG_STEP
+    unsigned faster = backlog / CONFIG_STDIO_FB_BACKLOG_STEP;
+    if (faster < CONFIG_STDIO_FB_SCROLL_FRAMES - CONFIG_STDIO_FB_SCROLL_FRAMES_MIN) {
+        return CONFIG_STDIO_FB_SCROLL_FRAMES - faster;
+    }
+    return CONFIG_STDIO_FB_SCROLL_FRAMES_MIN;
+#else
+    (void)backlog;
+    return CONFIG_STDIO_FB_SCROLL_FRAMES;
+#endif
+}
+
+static void *_scroller(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        unsigned irq_state = irq_disable();
+        if (!pending()) {
+            scrolling = false;
+            irq_restore(irq_state);
+            mutex_unlock(&idle_signal);
+            mutex_lock(&data_signal);
+            continue;
+        }
+        scrolling = true;
+        irq_restore(irq_state);
+
+        size_t len = 0;
+#if MODULE_STDIO_FB_LOG
+        /* log entries take precedence over regular output */
+        len = take_log_line();
+#endif
+        if (!len) {
+            len = take_output_line();
+#if CONFIG_STDIO_FB_OVERFLOW == STDIO_FB_OVERFLOW_BLOCK
+            mutex_unlock(&space_signal);
+#endif
+        }
+
+        if (len) {
+            led_matrix_text_scroll_adaptive(STDIO_LED_MATRIX_FONT, line, len,
+                                            STDIO_LED_MATRIX_BRIGHTNESS,
+                                            scroll_speed, NULL);
+        }
+    }
+
+    return NULL;
+}
+
 static void _init(void)
 {
     int retval = led_matrix_init();
     assert(retval == 0);
     (void)retval;
+
+    thread_create(stack, sizeof(stack), CONFIG_STDIO_FB_PRIO, 0, _scroller,
+                  NULL, "stdio_fb");
 }
 
-static ssize_t _write(const void *_buffer, size_t len)
+#if CONFIG_STDIO_FB_OVERFLOW == STDIO_FB_OVERFLOW_DROP_OLD
+/* make room for len bytes by dropping whole lines, oldest first */
+static void drop_old(size_t len)
 {
-    const char *buffer = _buffer;
-    size_t retval = len;
+    int c;
+    do {
+        c = tsrb_get_one(&rb);
+    } while ((c >= 0) && ((c != '\n') || (tsrb_free(&rb) < len)));
+}
+#endif
 
-    if (irq_is_in()) {
-        return 0;
+static ssize_t _write(const void *buffer, size_t len)
+{
+    const uint8_t *pos = buffer;
+    size_t left = len;
+
+#if CONFIG_STDIO_FB_OVERFLOW == STDIO_FB_OVERFLOW_DROP_OLD
+    if (left > sizeof(buf)) {
+        /* only the tail fits at all */
+        pos += left - sizeof(buf);
+        left = sizeof(buf);
     }
+    /* no other writer may fill up the room in between */
+    unsigned irq_state = irq_disable();
+    if (tsrb_free(&rb) < left) {
+        drop_old(left);
+    }
+#endif
 
-    for (size_t nlpos = 0; nlpos < len; nlpos++) {
-        if (buffer[nlpos] == '\n') {
-            led_matrix_text_scroll(STDIO_LED_MATRIX_FONT, buffer, nlpos,
-                                   STDIO_LED_MATRIX_BRIGHTNESS);
+    int added = tsrb_add(&rb, pos, left);
+#if CONFIG_STDIO_FB_OVERFLOW == STDIO_FB_OVERFLOW_DROP_OLD
+    irq_restore(irq_state);
+#endif
+    stdio_fb_notify();
 
-            len -= nlpos + 1;
-            buffer += nlpos + 1;
-            nlpos = 0;
+#if CONFIG_STDIO_FB_OVERFLOW == STDIO_FB_OVERFLOW_BLOCK
+    /* blocking is only possible in thread context */
+    if (!irq_is_in() && (thread_get_active() != NULL)) {
+        while ((size_t)added < left) {
+            pos += added;
+            left -= added;
+            mutex_lock(&space_signal);
+            added = tsrb_add(&rb, pos, left);
+            stdio_fb_notify();
         }
     }
+#else
+    (void)added;
+#endif
 
-    if (len) {
-        led_matrix_text_scroll(STDIO_LED_MATRIX_FONT, buffer, len,
-                               STDIO_LED_MATRIX_BRIGHTNESS);
-    }
+    /* report everything as written, dropping is a matter of the policy */
+    return len;
+}
 
-    return retval;
+void stdio_fb_flush(void)
+{
+    assert(!irq_is_in());
+
+    /* idle_signal may still be unlocked from an earlier idle phase */
+    while (pending() || scrolling) {
+        mutex_lock(&idle_signal);
+    }
 }
 
 STDIO_PROVIDER(STDIO_UART, _init, NULL, _write)
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_stdio_fb_log  ISR-safe Logging to the LED Matrix
+ * @ingroup     sys_stdio_fb
+ *
+ * With module `stdio_fb_log` short diagnostic messages can be shown on the
+ * LED matrix from any context, including ISRs, without a UART attached.
+ *
+ * A log entry is only a pointer to a constant message and a number. Adding
+ * it does no formatting and takes no locks, just a few loads and stores. The
+ * scroller thread of `stdio_fb` formats the entries as `<msg> <arg>` and
+ * scrolls them, before any regular output still waiting.
+ *
+ * Every context has its own lock-free ring buffer with a single producer.
+ * A context must therefore only be used by code that cannot preempt
+ * itself, e.g. by ISRs of the same priority or by a single thread. Context
+ * @ref STDIO_FB_LOG_CTX_ISR is meant for ISRs of the default priority, which
+ * is what the drivers of this repository use.
+ *
+ * Entries not fitting into the ring buffer are counted and reported as
+ * dropped.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the `stdio_fb_log` module
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ */
+
+#ifndef STDIO_FB_LOG_H
+#define STDIO_FB_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of log contexts
+ */
+#ifndef CONFIG_STDIO_FB_LOG_CONTEXTS
+#  define CONFIG_STDIO_FB_LOG_CONTEXTS  1
+#endif
+
+/**
+ * @brief   Number of entries per context (must be a power of two)
+ */
+#ifndef CONFIG_STDIO_FB_LOG_ENTRIES
+#  define CONFIG_STDIO_FB_LOG_ENTRIES   8
+#endif
+
+/**
+ * @brief   Context for ISRs of the default priority
+ */
+#define STDIO_FB_LOG_CTX_ISR            0
+
+/**
+ * @brief   A log entry
+ */
+typedef struct {
+    const char *msg;    /**< Constant message */
+    uint32_t arg;       /**< Number shown after the message */
+} stdio_fb_log_entry_t;
+
+/**
+ * @brief   Add an entry to the log
+ *
+ * @param[in]   ctx     Context to log to, see @ref sys_stdio_fb_log
+ * @param[in]   msg     Message to show, must stay valid until shown (e.g. a
+ *                      string literal)
+ * @param[in]   arg     Number to show after the message
+ *
+ * @retval  true    Entry added
+ * @retval  false   Log of @p ctx is full, entry dropped
+ */
+bool stdio_fb_log(unsigned ctx, const char *msg, uint32_t arg);
+
+/**
+ * @brief   Take the oldest entry of the given context out of the log
+ *
+ * @param[in]   ctx     Context to take the entry from
+ * @param[out]  entry   The entry taken
+ *
+ * @retval  true    @p entry was written
+ * @retval  false   Log of @p ctx is empty
+ *
+ * @note    Called by the scroller thread of `stdio_fb`
+ */
+bool stdio_fb_log_take(unsigned ctx, stdio_fb_log_entry_t *entry);
+
+/**
+ * @brief   Get the number of entries of the given context dropped since
+ *          the last call
+ *
+ * @param[in]   ctx     Context to check
+ *
+ * @note    Called by the scroller thread of `stdio_fb`
+ */
+uint32_t stdio_fb_log_dropped(unsigned ctx);
+
+/**
+ * @brief   Check if any context has entries not yet taken
+ */
+bool stdio_fb_log_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STDIO_FB_LOG_H */
+/** @} */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 Marian Buschsieweke
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_stdio_fb_log
+ * @{
+ *
+ * @file
+ * @brief       Lock-free log buffers for the LED matrix console
+ *
+ * @author      Marian Buschsieweke <marian.buschsieweke@posteo.net>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "atomic_utils.h"
+#include "stdio_fb.h"
+#include "stdio_fb_log.h"
+
+#define LOG_MASK    (CONFIG_STDIO_FB_LOG_ENTRIES - 1)
+
+static_assert((CONFIG_STDIO_FB_LOG_ENTRIES & LOG_MASK) == 0,
+              "CONFIG_STDIO_FB_LOG_ENTRIES must be a power of two");
+static_assert(CONFIG_STDIO_FB_LOG_ENTRIES <= 128,
+              "CONFIG_STDIO_FB_LOG_ENTRIES must fit the 8 bit indices");
+
+/* single producer (the context), single consumer (scroller thread) ring
+ * buffer per context */
+struct log {
+    stdio_fb_log_entry_t entries[CONFIG_STDIO_FB_LOG_ENTRIES];
+    uint8_t head;
+    uint8_t tail;
+    uint32_t dropped;
+    /* only accessed by the consumer */
+    uint32_t dropped_reported;
+};
+
+static struct log logs[CONFIG_STDIO_FB_LOG_CONTEXTS];
+
+bool stdio_fb_log(unsigned ctx, const char *msg, uint32_t arg)
+{
+    assert(ctx < CONFIG_STDIO_FB_LOG_CONTEXTS);
+    struct log *log = &logs[ctx];
+    uint8_t head = log->head;
+    uint8_t tail = atomic_load_u8(&log->tail);
+
+    if ((uint8_t)(head - tail) >= CONFIG_STDIO_FB_LOG_ENTRIES) {
+        atomic_store_u32(&log->dropped, log->dropped + 1);
+        return false;
+    }
+
+    stdio_fb_log_entry_t *entry = &log->entries[head & LOG_MASK];
+    entry->msg = msg;
+    entry->arg = arg;
+    /* publish the entry only after it has been written */
+    atomic_store_u8(&log->head, head + 1);
+
+    /* the scroller drains the logs before going to sleep, so only waking
+     * it up on the first entry is sufficient */
+    if (head == tail) {
+        stdio_fb_notify();
+    }
+
+    return true;
+}
+
+bool stdio_fb_log_take(unsigned ctx, stdio_fb_log_entry_t *entry)
+{
+    assert(ctx < CONFIG_STDIO_FB_LOG_CONTEXTS);
+    struct log *log = &logs[ctx];
+    uint8_t tail = log->tail;
+
+    if (atomic_load_u8(&log->head) == tail) {
+        return false;
+    }
+
+    *entry = log->entries[tail & LOG_MASK];
+    /* release the slot only after it has been read */
+    atomic_store_u8(&log->tail, tail + 1);
+
+    return true;
+}
+
+uint32_t stdio_fb_log_dropped(unsigned ctx)
+{
+    assert(ctx < CONFIG_STDIO_FB_LOG_CONTEXTS);
+    struct log *log = &logs[ctx];
+    uint32_t dropped = atomic_load_u32(&log->dropped);
+    uint32_t result = dropped - log->dropped_reported;
+
+    log->dropped_reported = dropped;
+    return result;
+}
+
+bool stdio_fb_log_pending(void)
+{
+    for (unsigned i = 0; i < CONFIG_STDIO_FB_LOG_CONTEXTS; i++) {
+        if ((atomic_load_u8(&logs[i].head) != logs[i].tail)
+                || (atomic_load_u32(&logs[i].dropped) != logs[i].dropped_reported)) {
+            return true;
+        }
+    }
+
+    return false;
+}